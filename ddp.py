@@ -1,40 +1,101 @@
 #!/usr/bin/env python3
 import socket
 import argparse
+import random
+import struct
+import time
 
-def create_packet(pixels=None):
-    """Create a DDP packet with specified pixels or all off"""
-    # Header: 10 bytes
-    packet = bytearray([
-        0x41,  # Version 1
-        0x00,  # Flags
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00  # Reserved
-    ])
+WIDTH = 16
+HEIGHT = 16
 
-    # Initialize all pixels to 0
-    data = bytearray([0] * (16 * 16 * 3))
+VERSION_1 = 0x40
+FLAG_TIMECODE = 0x10
+FLAG_PUSH = 0x01
+TYPE_RGB8 = 0x0B
+TYPE_GRAY8 = 0x23
+ID_DISPLAY = 1
+
+
+def create_frame(pixels=None, gray=False):
+    """Channel data of a frame with specified pixels or all off"""
+    size = 1 if gray else 3
+    data = bytearray([0] * (WIDTH * HEIGHT * size))
 
     # Set specified pixels
     if pixels:
         for x, y, brightness in pixels:
-            if 0 <= x < 16 and 0 <= y < 16 and 0 <= brightness <= 255:
-                index = (y * 16 + x) * 3
-                data[index:index + 3] = [brightness] * 3
+            if 0 <= x < WIDTH and 0 <= y < HEIGHT and 0 <= brightness <= 255:
+                index = (y * WIDTH + x) * size
+                data[index:index + size] = [brightness] * size
+    return data
+
 
+def create_packet(data, offset=0, sequence=0, push=True, gray=False, timecode=None):
+    """Create a DDP packet carrying data at the given channel offset"""
+    flags = VERSION_1
+    if push:
+        flags |= FLAG_PUSH
+    if timecode is not None:
+        flags |= FLAG_TIMECODE
+    # Header: 10 bytes, 14 with timecode
+    packet = bytearray(struct.pack('>BBBBIH', flags, sequence & 0x0F,
+                                   TYPE_GRAY8 if gray else TYPE_RGB8, ID_DISPLAY,
+                                   offset, len(data)))
+    if timecode is not None:
+        packet.extend(struct.pack('>I', timecode & 0xFFFFFFFF))
     packet.extend(data)
     return packet
 
-def send_ddp_packet(ip, port, packet):
-    """Send a DDP packet to the specified IP and port"""
-    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
-    try:
+
+def create_packets(data, chunks=1, sequence=0, gray=False, timecode=None):
+    """Split a frame into chunks packets, only the last one pushes"""
+    size = 1 if gray else 3
+    pixels = len(data) // size
+    step = -(-pixels // chunks) * size
+    packets = []
+    for offset in range(0, len(data), step):
+        last = offset + step >= len(data)
+        packets.append(create_packet(data[offset:offset + step], offset, sequence,
+                                     push=last, gray=gray, timecode=timecode))
+        if sequence:
+            # numbers run 1 to 15, 0 means unnumbered
+            sequence = sequence % 15 + 1
+    return packets, sequence
+
+
+def send_packets(sock, ip, port, packets, verbose=True):
+    """Send DDP packets to the specified IP and port"""
+    for packet in packets:
         sock.sendto(packet, (ip, port))
-        print(f"Sent DDP packet to {ip}:{port}")
-        print(f"Packet size: {len(packet)} bytes")
-    except Exception as e:
-        print(f"Error: {e}")
-    finally:
-        sock.close()
+        if verbose:
+            print(f"Sent DDP packet to {ip}:{port}, {len(packet)} bytes")
+
+
+def stream(sock, args):
+    """Moving test pattern, optionally with duplicate and reordered packets
+    to check the drop counters in /api/info"""
+    sequence = 1
+    interval = 1.0 / args.fps
+    start = time.time()
+    sent = duplicates = reordered = 0
+    for frame in range(args.frames):
+        pixels = [(x, y, 255 if (x + y + frame) % 8 == 0 else 0)
+                  for x in range(WIDTH) for y in range(HEIGHT)]
+        timecode = int((time.time() - start) * 65536)
+        packets, sequence = create_packets(create_frame(pixels, args.gray), args.chunks,
+                                           sequence, args.gray, timecode if args.timecode else None)
+        if len(packets) > 1 and random.random() < args.reorder:
+            packets[0], packets[1] = packets[1], packets[0]
+            reordered += 1
+        if random.random() < args.duplicate:
+            packets.insert(1, packets[0])
+            duplicates += 1
+        send_packets(sock, args.ip, args.port, packets, verbose=False)
+        sent += len(packets)
+        time.sleep(max(0, start + (frame + 1) * interval - time.time()))
+    print(f"Sent {args.frames} frames in {sent} packets, "
+          f"{duplicates} with a duplicate, {reordered} reordered")
+
 
 def main():
     parser = argparse.ArgumentParser(description='Send DDP packets to control LED matrix')
@@ -46,9 +107,25 @@ def main():
     parser.add_argument('--pixel', nargs=3, type=int, action='append',
                        metavar=('X', 'Y', 'BRIGHTNESS'),
                        help='Set pixel at X,Y to brightness (can be used multiple times)')
+    parser.add_argument('--chunks', type=int, default=1,
+                       help='Split each frame into this many packets, pushed by the last one')
+    parser.add_argument('--gray', action='store_true',
+                       help='Send 8 bit grayscale instead of RGB')
+    parser.add_argument('--timecode', action='store_true', help='Add a timecode to streamed frames')
+    parser.add_argument('--stream', action='store_true',
+                       help='Stream a moving test pattern with numbered packets')
+    parser.add_argument('--fps', type=float, default=30, help='Frames per second when streaming')
+    parser.add_argument('--frames', type=int, default=300, help='Number of frames to stream')
+    parser.add_argument('--duplicate', type=float, default=0,
+                       help='Share of streamed frames with a duplicated packet (0-1)')
+    parser.add_argument('--reorder', type=float, default=0,
+                       help='Share of streamed frames with swapped packets (0-1)')
 
     args = parser.parse_args()
 
+    if args.chunks < 1:
+        parser.error("Chunks must be at least 1")
+
     # Validate fill brightness
     if args.fill is not None and not 0 <= args.fill <= 255:
         parser.error("Fill brightness must be between 0 and 255")
@@ -57,18 +134,29 @@ def main():
     pixels = []
     if args.pixel:
         for x, y, brightness in args.pixel:
-            if not (0 <= x < 16 and 0 <= y < 16):
+            if not (0 <= x < WIDTH and 0 <= y < HEIGHT):
                 parser.error(f"Invalid coordinates: {x},{y} (must be 0-15)")
             if not (0 <= brightness <= 255):
                 parser.error(f"Invalid brightness: {brightness} (must be 0-255)")
             pixels.append((x, y, brightness))
 
-    # Create appropriate packet
-    if args.fill is not None:
-        pixels = [(x, y, args.fill) for x in range(16) for y in range(16)]
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    try:
+        if args.stream:
+            stream(sock, args)
+            return
+
+        # Create appropriate packets
+        if args.fill is not None:
+            pixels = [(x, y, args.fill) for x in range(WIDTH) for y in range(HEIGHT)]
+
+        packets, _ = create_packets(create_frame(pixels, args.gray), args.chunks, gray=args.gray)
+        send_packets(sock, args.ip, args.port, packets)
+    except Exception as e:
+        print(f"Error: {e}")
+    finally:
+        sock.close()
 
-    packet = create_packet(pixels)
-    send_ddp_packet(args.ip, args.port, packet)
 
 if __name__ == "__main__":
-    main()
\ No newline at end of file
+    main()
@@ -2,6 +2,7 @@
 
 #include <ArduinoJson.h>
 #include <Arduino.h>
+#include <atomic>
 #include <vector>
 #include <string>
 
@@ -9,6 +10,44 @@
 #include "signs.h"
 #include "websocket.h"
 
+// pause after loop() for plugins without a frame period, as before the scheduler
+#define SELF_PACED_PERIOD_US 10000
+// time a loop() of a plugin without a frame period may take, only counted
+// as an overrun since such plugins pace themselves with delay()
+#define SELF_PACED_BUDGET_US 20000
+
+// A tick over budget adds OVERRUN_STRIKES, a tick within takes one away.
+// At DEMOTE_STRIKES the frame period of the plugin doubles, a plugin that
+// still overruns after MAX_DEMOTIONS is switched out. Plugins without a frame
+// period are never demoted.
+#define OVERRUN_STRIKES 4
+#define DEMOTE_STRIKES 32
+#define MAX_DEMOTIONS 3
+
+// a tick running this long restarts the device, the plugin stays off until
+// the next restart. Not armed for plugins without a frame period, whose
+// loop() may block for seconds.
+#define PLUGIN_HANG_MS 5000
+
+// the active plugin as other tasks see it, refreshed this often
+#define PLUGIN_SNAPSHOT_MS 250
+// room for addStats() as serialized JSON
+#define PLUGIN_STATS_SIZE 512
+
+// frame timing of a plugin since it was activated
+struct FrameStats
+{
+    uint32_t frames = 0;
+    uint32_t deadlineMisses = 0; // frames dropped because a tick started a period late
+    uint32_t maxLateUs = 0;      // worst delay of a tick after its due time
+    uint32_t avgLateUs = 0;      // running average, each tick weighs 1/8
+    uint32_t overruns = 0;       // ticks that took longer than the budget
+    uint32_t maxTickUs = 0;
+    uint32_t avgTickUs = 0;      // running average, each tick weighs 1/8
+    uint8_t strikes = 0;
+    uint8_t demotions = 0;       // the frame period is doubled this often
+};
+
 class Plugin
 {
 private:
@@ -21,12 +60,36 @@ public:
 
     virtual void teardown();
     virtual void websocketHook(DynamicJsonDocument &request);
+    // plugin specific counters for /api/info, e.g. of a stream receiver
+    virtual void addStats(JsonObject object);
     virtual void setup() = 0;
     virtual void loop();
+    // Called once per frame period with micros() and the time since the last
+    // tick. The default runs loop() for plugins that pace themselves.
+    virtual void tick(uint32_t now, uint32_t dt);
+    // frame period in ms, 0 if loop() does its own pacing
+    virtual uint16_t getFramePeriod() const;
+    // time in us one tick may take, the frame period by default
+    virtual uint32_t getFrameBudget() const;
     virtual const char *getName() const = 0;
 
     void setId(int id);
     int getId() const;
+
+    FrameStats frameStats;
+    // overruns over all activations since boot
+    uint32_t overruns = 0;
+};
+
+// copy of the active plugin's state for /api/info, taken between frames by
+// the drawing task
+struct PluginSnapshot
+{
+    int id = -1;
+    uint16_t periodMs = 0;
+    uint32_t budgetUs = 0;
+    FrameStats frameStats;
+    char stats[PLUGIN_STATS_SIZE] = "{}";
 };
 
 class PluginManager
@@ -36,6 +99,19 @@ private:
     Plugin *activePlugin;
     int nextPluginId;
     int persistedPluginId = 1;
+    uint32_t nextFrameUs = 0;
+    uint32_t lastTickUs = 0;
+    // millis() when the running tick started, 0 between ticks
+    volatile uint32_t tickStartedMs = 0;
+    // hung before the last restart, not activated until the next
+    std::string blockedPlugin;
+    // odd while publishSnapshot() writes snapshot
+    std::atomic<uint32_t> snapshotSequence{0};
+    PluginSnapshot snapshot;
+    unsigned long lastSnapshotMs = 0;
+
+    void checkBudget(uint32_t tookUs, bool framed);
+    void publishSnapshot();
 
 public:
     PluginManager();
@@ -43,12 +119,21 @@ public:
     int addPlugin(Plugin *plugin);
     void setActivePlugin(const char *pluginName);
     void setActivePluginById(int pluginId);
-    void runActivePlugin();
+    // ticks the active plugin when its frame is due, returns the us until the
+    // next one
+    uint32_t runActivePlugin();
+    // restarts the device if the active plugin hangs in a tick, called from
+    // outside the drawing task
+    void checkWatchdog();
+    // copies the latest snapshot of the active plugin, any task. False while
+    // no plugin is active.
+    bool getSnapshot(PluginSnapshot &copy) const;
     void setupActivePlugin();
     void activateNextPlugin();
     void persistActivePlugin();
     void init();
     void activatePersistedPlugin();
+    // changes between frames, other tasks use getSnapshot()
     Plugin *getActivePlugin() const;
     std::vector<Plugin *> &getAllPlugins();
     size_t getNumPlugins();
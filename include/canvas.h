@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Arduino.h>
+#include "constants.h"
+#include "signs.h"
+
+// Draws a 1 bit per pixel glyph into a ROWS * COLS buffer. Rows are packed
+// back to back MSB first like the tables in signs.h, in flash or RAM. The
+// glyph rectangle is clipped once, set bits become value and clear bits are
+// drawn as off unless transparent.
+void blitGlyph(uint8_t *pixels, int x, int y, const uint8_t *bits, int width, int height, uint8_t value, bool transparent);
+
+// Off-screen frame for plugins that redraw a lot per frame. Primitives clip
+// once per call and write the buffer directly, Screen.present(canvas) then
+// hands the finished frame over in a single commit.
+class Canvas
+{
+public:
+  uint8_t pixels[ROWS * COLS] = {};
+
+  void clear(uint8_t value = 0)
+  {
+    memset(pixels, value, sizeof(pixels));
+  }
+
+  uint8_t getPixel(int x, int y) const
+  {
+    return (unsigned)x < COLS && (unsigned)y < ROWS ? pixels[y * COLS + x] : 0;
+  }
+
+  void setPixel(int x, int y, uint8_t value)
+  {
+    if ((unsigned)x < COLS && (unsigned)y < ROWS)
+    {
+      pixels[y * COLS + x] = value;
+    }
+  }
+
+  // horizontal run of width pixels starting at x
+  void fillSpan(int x, int y, int width, uint8_t value)
+  {
+    if ((unsigned)y >= ROWS)
+    {
+      return;
+    }
+    if (x < 0)
+    {
+      width += x;
+      x = 0;
+    }
+    width = min(width, COLS - x);
+    if (width > 0)
+    {
+      memset(pixels + y * COLS + x, value, width);
+    }
+  }
+
+  void drawHLine(int x1, int x2, int y, uint8_t value)
+  {
+    fillSpan(min(x1, x2), y, abs(x2 - x1) + 1, value);
+  }
+
+  void drawVLine(int x, int y1, int y2, uint8_t value)
+  {
+    if ((unsigned)x >= COLS)
+    {
+      return;
+    }
+    int from = max(min(y1, y2), 0);
+    int to = min(max(y1, y2), ROWS - 1);
+    for (uint8_t *pixel = pixels + from * COLS + x; from <= to; from++, pixel += COLS)
+    {
+      *pixel = value;
+    }
+  }
+
+  void fillRect(int x, int y, int width, int height, uint8_t value);
+  void drawRect(int x, int y, int width, int height, uint8_t value);
+  void drawLine(int x1, int y1, int x2, int y2, uint8_t value);
+
+  void blit(int x, int y, const uint8_t *bits, int width, int height, uint8_t value = 255, bool transparent = false)
+  {
+    blitGlyph(pixels, x, y, bits, width, height, value, transparent);
+  }
+
+  void blit(int x, int y, const Glyph &glyph, uint8_t value = 255, bool transparent = false)
+  {
+    blitGlyph(pixels, x, y, glyph.bits, glyph.width, glyph.height, value, transparent);
+  }
+};
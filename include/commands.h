@@ -0,0 +1,80 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+// Control requests from the network task, the button and the scheduler. They
+// are posted from any task and applied by the drawing task between frames,
+// so the active plugin is never switched or configured while it draws.
+enum CommandType : uint8_t
+{
+  CMD_SET_PLUGIN,       // value: plugin id
+  CMD_NEXT_PLUGIN,
+  CMD_PERSISTED_PLUGIN,
+  CMD_PERSIST_PLUGIN,
+  CMD_BRIGHTNESS,       // value: 0 - 255, stored
+  CMD_ROTATE,           // value: quarter turns clockwise, stored
+  CMD_TUNE_REFRESH,
+  CMD_PLUGIN_EVENT,     // payload: DynamicJsonDocument for websocketHook()
+  CMD_ADD_MESSAGE,      // payload: Message, value: urgent
+  CMD_REMOVE_MESSAGE,   // value: message id
+  CMD_SCROLL_MESSAGES,
+  CMD_INGEST_SETTINGS,  // payload: IngestSettings
+  CMD_SEND_ANIMATION,   // value: websocket client id
+};
+
+struct Command
+{
+  CommandType type;
+  int32_t value = 0;
+  // heap object owned by the queue once posted, deleted after it is applied
+  void *payload = nullptr;
+};
+
+#define COMMAND_QUEUE_SIZE 16
+static_assert((COMMAND_QUEUE_SIZE & (COMMAND_QUEUE_SIZE - 1)) == 0, "queue size must be a power of two");
+
+class Commands_
+{
+private:
+  Commands_();
+
+  // bounded multi producer, single consumer ring. A slot's sequence tells
+  // whether it is free for position n (n) or holds the command of n (n + 1).
+  struct Slot
+  {
+    std::atomic<uint32_t> sequence;
+    Command command;
+  };
+  Slot slots_[COMMAND_QUEUE_SIZE];
+  std::atomic<uint32_t> head_{0};
+  uint32_t tail_ = 0;
+  std::atomic<uint32_t> dropped_{0};
+#ifdef ESP32
+  TaskHandle_t consumer_ = nullptr;
+#endif
+
+  void release(Command &command);
+  void execute(Command &command);
+
+public:
+  static Commands_ &getInstance();
+
+  Commands_(const Commands_ &) = delete;
+  Commands_ &operator=(const Commands_ &) = delete;
+
+  // never blocks, false (and the payload deleted) if the queue is full
+  bool post(CommandType type, int32_t value = 0, void *payload = nullptr);
+  // runs every queued command, drawing task only
+  void apply();
+  uint32_t getDropped() const;
+  // lets the drawing task run now instead of after its sleep
+  void wake();
+
+#ifdef ESP32
+  // woken by post() so commands do not wait for the next frame
+  void setConsumer(TaskHandle_t task);
+#endif
+};
+
+extern Commands_ &Commands;
@@ -28,6 +28,27 @@
 #define ENABLE_STORAGE
 #endif
 
+// enable to refresh the panel with binary coded modulation (6 bit-planes per
+// refresh) instead of 64 PWM passes. Less interrupt load, same gray levels.
+// #define ENABLE_BCM_REFRESH
+
+// the refresh is tuned at boot: share of CPU time the refresh interrupt may
+// use, the shortest tick and the refresh rate that must not be undercut
+#define REFRESH_ISR_BUDGET_PERCENT 25
+#define REFRESH_MIN_INTERVAL_US 100
+#define REFRESH_MIN_HZ 100
+
+// enable to collect refresh interrupt statistics for /api/metrics and the
+// "metrics" websocket event, adds a little work to every refresh tick
+// #define ENABLE_REFRESH_METRICS
+
+// network streams (DDP, Art-Net, websocket): gamma applied to every pixel
+// (1 for none), values up to the black level are off, and the weights of
+// red, green and blue (LUMA_AVERAGE, LUMA_BT601, LUMA_BT709)
+#define INGEST_GAMMA 1.0f
+#define INGEST_BLACK_LEVEL 4
+#define INGEST_LUMA LUMA_AVERAGE
+
 #ifdef ENABLE_SERVER
 // https://github.com/nayarsystems/posix_tz_db/blob/master/zones.json
 #define NTP_SERVER "de.pool.ntp.org"
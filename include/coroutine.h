@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Stackless coroutines for sequential plugin animations. A tick() written as
+//
+//   CO_BEGIN(co);
+//   for (step = 0; step < 32; step++)
+//   {
+//     ...
+//     CO_SLEEP(co, 24);
+//   }
+//   CO_END(co);
+//
+// returns to the frame scheduler at every CO_NEXT_FRAME() / CO_SLEEP() and
+// carries on from there on the next tick. Nothing is allocated, the resume
+// point lives in the Coroutine and locals do not survive a suspension, so
+// loop counters and other state belong in plugin members. Only one CO_ macro
+// per source line.
+struct Coroutine
+{
+  uint16_t line = 0;
+  unsigned long wakeMs = 0;
+
+  void reset()
+  {
+    line = 0;
+  }
+};
+
+#define CO_BEGIN(co) \
+  switch ((co).line) \
+  {                  \
+  case 0:
+
+// suspends until the next tick
+#define CO_NEXT_FRAME(co) \
+  do                      \
+  {                       \
+    (co).line = __LINE__; \
+    return;               \
+  case __LINE__:;         \
+  } while (0)
+
+// suspends for at least ms, rounded up to whole frames
+#define CO_SLEEP(co, ms)                                \
+  do                                                    \
+  {                                                     \
+    (co).wakeMs = millis() + (ms);                      \
+    (co).line = __LINE__;                               \
+    [[fallthrough]];                                    \
+  case __LINE__:                                        \
+    if ((long)(millis() - (co).wakeMs) < 0)             \
+    {                                                   \
+      return;                                           \
+    }                                                   \
+  } while (0)
+
+// starts over from CO_BEGIN() on the next tick
+#define CO_END(co) \
+  }                \
+  (co).line = 0
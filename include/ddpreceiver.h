@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Arduino.h>
+#include "constants.h"
+#include "ingestkernels.h"
+
+#define DDP_PORT 4048
+#define DDP_HEADER_SIZE 10
+#define DDP_TIMECODE_SIZE 4
+
+// byte 0
+#define DDP_VERSION_MASK 0xC0
+#define DDP_VERSION_1 0x40
+#define DDP_FLAG_TIMECODE 0x10
+#define DDP_FLAG_QUERY 0x02
+#define DDP_FLAG_PUSH 0x01
+// byte 2, 8 bit RGB and grayscale, 0 means undefined and is taken as RGB
+#define DDP_TYPE_UNDEFINED 0x00
+#define DDP_TYPE_RGB8 0x0B
+#define DDP_TYPE_GRAY8 0x23
+// byte 3, everything else is status, config or control
+#define DDP_ID_DISPLAY 1
+
+// RGB is the widest format taken, grayscale uses the first third
+#define DDP_CHANNELS (ROWS * COLS * 3)
+// a sequence number further back than this is a late packet, not a wrap
+#define DDP_SEQUENCE_WINDOW 7
+// after this long without packets any sequence number is taken
+#define DDP_SEQUENCE_RESET_MS 1000
+
+struct DDPStats
+{
+  uint32_t packets = 0;
+  uint32_t frames = 0;        // pushes
+  uint32_t malformed = 0;     // bad header, type, id or length
+  uint32_t outOfOrder = 0;    // duplicate or late sequence number
+  uint32_t staleFrames = 0;   // pushes with a timecode older than the last
+  uint16_t packetsPerSecond = 0;
+  uint16_t framesPerSecond = 0;
+};
+
+// The protocol side of the DDP plugin: header checks, sequence numbers and
+// timecodes, and the frame assembled from the packets up to a push. It is
+// handed datagrams and keeps no socket, see test/test_ddp.
+class DDPReceiver
+{
+private:
+  // channel data as sent, assembled from all packets up to a push
+  uint8_t channels_[DDP_CHANNELS] = {};
+  uint8_t bytesPerPixel_ = 3;
+
+  uint8_t lastSequence_ = 0;
+  unsigned long lastPacketMs_ = 0;
+  bool hasTimecode_ = false;
+  uint32_t lastTimecode_ = 0;
+
+  uint32_t windowStartMs_ = 0;
+  uint32_t windowPackets_ = 0;
+  uint32_t windowFrames_ = 0;
+
+  bool acceptSequence(uint8_t sequence, unsigned long now);
+  void countRates(unsigned long now);
+
+public:
+  DDPStats stats;
+
+  // forgets the frame, sequence, timecode and counters
+  void reset();
+  // handles one datagram, true if it pushed a frame
+  bool receive(const uint8_t *data, size_t length);
+
+  // the frame as of the last push, pixels no packet covered keep their value
+  IngestFormat getFormat() const;
+  const uint8_t *getChannels() const;
+  size_t getFrameSize() const;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Arduino.h>
+#include "constants.h"
+#include "ingestkernels.h"
+
+#define DMX_SLOTS 512
+// a panel spans 2 universes with RGB, whole pixels per universe
+#define DMX_FRAME_MAX_UNIVERSES 2
+
+// Assembles a panel frame from consecutive DMX universes, for Art-Net and
+// sACN. A pixel takes 1 slot (8 bit gray), 2 slots (16 bit gray, coarse
+// first) or 3 slots (RGB) and never spans two universes. The newest
+// complete frame is kept aside until take(), so a receiver can drain its
+// socket before it hands the frame to the ingest stage. Nothing here
+// touches the hardware, see test/test_sacn.
+class DmxFrame
+{
+private:
+  uint8_t channelsPerPixel_ = 1;
+  uint16_t pixelsPerUniverse_ = DMX_SLOTS;
+  uint8_t universes_ = 1;
+
+  uint8_t pixels_[ROWS * COLS * 3] = {};
+  // universes written since the last frame, bit 0 is the first
+  uint8_t received_ = 0;
+  uint8_t complete_[ROWS * COLS * 3] = {};
+  bool hasComplete_ = false;
+  uint32_t completeUs_ = 0;
+
+public:
+  uint32_t frames = 0;
+  uint32_t stale = 0; // complete frames replaced by a newer one before take()
+
+  void configure(uint8_t channelsPerPixel);
+  uint8_t getChannelsPerPixel() const;
+  uint8_t getUniverses() const;
+  // INGEST_RGB8 with 3 channels per pixel, INGEST_GRAY8 otherwise
+  IngestFormat getFormat() const;
+
+  // takes the slots of the universe at index from the first. Unless
+  // synchronous, the frame is complete once every universe arrived, or when
+  // one comes twice because the sender skipped another.
+  void write(uint8_t index, const uint8_t *slots, uint16_t length, bool synchronous);
+  // the universes written so far become the next frame, e.g. on a sync
+  void complete();
+  // the newest complete frame in getFormat(), nullptr if none completed
+  // since the last call. completeUs is when it was complete.
+  const uint8_t *take(uint32_t &completeUs);
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Arduino.h>
+#include "constants.h"
+
+// Whole frame kernels for ambient effects. They work on a full ROWS * COLS
+// buffer, e.g. Canvas::pixels or Screen.getRenderBuffer(), and process four
+// pixels per 32 bit word instead of going through setPixel().
+namespace Effects
+{
+  enum Direction
+  {
+    LEFT,
+    RIGHT,
+    UP,
+    DOWN,
+  };
+
+  // value * factor / 256, so 128 halves and 256 keeps the frame
+  void scale(uint8_t *buffer, uint16_t factor);
+  // value - amount, stopping at 0
+  void decay(uint8_t *buffer, uint8_t amount);
+  // buffer + source, stopping at 255
+  void addSaturate(uint8_t *buffer, const uint8_t *source);
+  // value > level ? on : 0
+  void threshold(uint8_t *buffer, uint8_t level, uint8_t on = 255);
+  // maps every value to values[i] of the highest thresholds[i] it exceeds,
+  // 0 below the first. thresholds must be ascending. Goes through a table,
+  // not per word like the others.
+  void quantize(uint8_t *buffer, const uint8_t *thresholds, const uint8_t *values, int count);
+  // moves the frame one pixel, filling the free row or column with fill or,
+  // with wrap, the pixels pushed out on the other side
+  void shift(uint8_t *buffer, Direction direction, bool wrap = false, uint8_t fill = 0);
+}
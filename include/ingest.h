@@ -0,0 +1,106 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include "constants.h"
+#include "ingestkernels.h"
+
+// how frames are turned into brightness, see constants.h for the defaults
+struct IngestSettings
+{
+  float gamma = INGEST_GAMMA;
+  uint8_t blackLevel = INGEST_BLACK_LEVEL;
+  LumaWeights luma = INGEST_LUMA;
+};
+
+struct IngestStats
+{
+  uint32_t frames = 0;     // submitted
+  uint32_t duplicates = 0; // equal to the frame before, not handed over
+  uint32_t collisions = 0; // dropped, another source was submitting
+  uint32_t shown = 0;      // taken by the drawing task
+  uint32_t stale = 0;      // replaced by a newer frame before it was shown
+  uint32_t maxConvertUs = 0;
+  uint32_t avgConvertUs = 0; // running average, each frame weighs 1/8
+  // from receiving a frame to showing it
+  uint32_t lastAgeUs = 0;
+  uint32_t maxAgeUs = 0;
+  uint32_t avgAgeUs = 0;     // running average, each frame weighs 1/8
+};
+
+// One stage every network stream (DDP, Art-Net, websocket) feeds. Frames
+// are converted straight into the back buffer of a triple buffer, mapped through an optional gamma table and handed to the
+// drawing task, which shows the newest one on LAYER_STREAM. A frame equal
+// to the last one is dropped by its hash before it costs a commit.
+class Ingest_
+{
+private:
+  Ingest_();
+
+  static const uint8_t FRESH = 0x80;
+
+  uint8_t buffers_[3][ROWS * COLS];
+  // micros() when the frame in the buffer was received
+  uint32_t receivedUs_[3] = {};
+  // owned by the submitting task
+  uint8_t back_ = 0;
+  // owned by the drawing task
+  uint8_t front_ = 1;
+  // index of the buffer in between, FRESH until the drawing task took it
+  std::atomic<uint8_t> ready_{2};
+
+  // input shorter than a frame is padded here, the kernels take whole frames
+  uint8_t scratch_[ROWS * COLS * 3];
+
+  // Conversion tables. configure() builds the spare set and switches to it,
+  // submit() takes the current set once per frame, so a frame converted on
+  // the network task never sees a table half rebuilt.
+  struct Tables
+  {
+    IngestSettings settings;
+    uint8_t lut[256];
+    const uint8_t *weights;
+    bool identity;
+    uint32_t version;
+  };
+  Tables tables_[2];
+  std::atomic<uint8_t> activeTables_{0};
+  uint32_t nextVersion_ = 1;
+
+  // owned by the submitting task, the hash is only compared with one taken
+  // with the same tables
+  uint32_t lastHash_ = 0;
+  uint32_t hashVersion_ = 0;
+
+  // Held by the task in submit() or reset(). The back buffer, scratch_, the
+  // hash and the submit counters belong to whoever holds it.
+  std::atomic<bool> busy_{false};
+
+  void build(Tables &tables, const IngestSettings &settings);
+
+public:
+  static Ingest_ &getInstance();
+
+  Ingest_(const Ingest_ &) = delete;
+  Ingest_ &operator=(const Ingest_ &) = delete;
+
+  // Converts a frame from the network, missing pixels are off. Called by
+  // the task receiving the stream. A frame arriving while another task
+  // submits is dropped rather than waited for. receivedUs is when the frame
+  // was complete, now if 0. False if the frame was dropped or a duplicate.
+  bool submit(IngestFormat format, const uint8_t *data, size_t length, uint32_t receivedUs = 0);
+  // shows the newest submitted frame, drawing task only
+  void apply();
+  // forgets pending frames and the duplicate hash when a source stops,
+  // waits for a submit in progress. Drawing task only.
+  void reset();
+
+  // Takes effect with the next frame. Drawing task only, other tasks post
+  // CMD_INGEST_SETTINGS.
+  void configure(const IngestSettings &settings);
+  IngestSettings getSettings() const;
+
+  IngestStats stats;
+};
+
+extern Ingest_ &Ingest;
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+#include "constants.h"
+
+// pixel formats network sources send, rows top to bottom
+enum IngestFormat : uint8_t
+{
+  INGEST_RGB8,  // 3 bytes per pixel, shown as luma
+  INGEST_GRAY8, // 1 byte per pixel
+  INGEST_GRAY4, // 2 pixels per byte, high nibble first
+  INGEST_MONO1, // 8 pixels per byte, MSB first
+};
+
+// weights of red, green and blue for INGEST_RGB8, in 1/256
+enum LumaWeights : uint8_t
+{
+  LUMA_AVERAGE, // (r + g + b) / 3
+  LUMA_BT601,
+  LUMA_BT709,
+};
+
+// The conversions behind Ingest_, on whole ROWS * COLS frames and, except
+// for RGB, four pixels per 32 bit word. They keep no state, see
+// test/test_ingest.
+namespace IngestKernels
+{
+  // bytes of a whole frame in format
+  size_t frameSize(IngestFormat format);
+  // red, green and blue in 1/256, each set sums to 256 so white stays 255
+  const uint8_t *lumaWeights(LumaWeights luma);
+  // lut[v] = v ^ gamma, values at or below blackLevel are off. True if the
+  // table changes nothing and can be skipped.
+  bool buildLut(uint8_t *lut, float gamma, uint8_t blackLevel);
+
+  void rgbToLuma(uint8_t *target, const uint8_t *source, const uint8_t *weights);
+  // every nibble n becomes n * 17
+  void gray4ToGray8(uint8_t *target, const uint8_t *source);
+  // set bits become on, the others 0
+  void mono1ToGray8(uint8_t *target, const uint8_t *source, uint8_t on);
+  void applyLut(uint8_t *frame, const uint8_t *lut);
+  // FNV-1a over whole words
+  uint32_t hashFrame(const uint8_t *frame);
+}
@@ -12,6 +12,7 @@ public:
   std::vector<int> graph;
   int miny;
   int maxy;
+  TextStrip strip;
 
   void reset()
   {
@@ -22,6 +23,7 @@ public:
     graph.clear();
     miny = 0;
     maxy = 0;
+    strip.clear();
   }
 };
 
@@ -75,8 +77,22 @@ private:
   std::vector<Message *> activeMessages;
 
   int previousMinute = -1;
-  int previousSecond = -1;
-  int indicatorPixel = 0;
+  int indicatorPixel = -1; // -1 while hidden
+
+  // playback of activeMessages, one scroll step per update()
+  bool playing = false;
+  size_t playIndex = 0;
+  bool playingGraph = false;
+  int scrollPosition = -COLS;
+  unsigned long lastStep = 0;
+  Canvas overlay;
+  Canvas indicator;
+
+  void rewind();
+  void next();
+  void drawGraph(const Message *msg);
+  uint32_t blinkIndicator();
+  uint32_t step();
 
 public:
   static Messages_ &getInstance();
@@ -84,11 +100,17 @@ public:
   Messages_(const Messages_ &) = delete;
   Messages_ &operator=(const Messages_ &) = delete;
 
+  // urgent messages interrupt the one being shown, which starts over after
   void add(std::string text, int repeat = 0, int id = 0, int delay = 50,
-           std::vector<int> graph = {}, int miny = 0, int maxy = 15);
+           std::vector<int> graph = {}, int miny = 0, int maxy = 15, bool urgent = false);
   void remove(int id = 0);
+  // starts showing all messages once, unless they already are
   void scroll();
   void scrollMessageEveryMinute();
+  // advances the message shown on top of the plugin by one step when due
+  // and blinks the indicator, called from the drawing loop after the active
+  // plugin. Returns the us until either is due again.
+  uint32_t update();
 
   ~Messages_()
   {
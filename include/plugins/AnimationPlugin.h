@@ -1,19 +1,22 @@
 #pragma once
 
+#include <array>
 #include "PluginManager.h"
 
 class AnimationPlugin : public Plugin
 {
 private:
   uint8_t step = 0;
-  std::vector<std::vector<int>> customAnimationFrames;
+  // 16x16 frames, 1 bit per pixel packed like the glyphs in signs.h
+  std::vector<std::array<uint8_t, 32>> customAnimationFrames;
 
 public:
   void setup() override;
-  void loop() override;
+  void tick(uint32_t now, uint32_t dt) override;
+  uint16_t getFramePeriod() const override;
   const char *getName() const override;
   void websocketHook(DynamicJsonDocument &request) override;
   // Expose current frames for minimal fetch via WebSocket
-  const std::vector<std::vector<int>> &getFrames() const;
+  const std::vector<std::array<uint8_t, 32>> &getFrames() const;
 
 };
@@ -3,20 +3,50 @@
 #include "PluginManager.h"
 
 #include "ArtnetWifi.h"
+#include "dmxframe.h"
+#include "ingest.h"
 
 #define START_UNIVERSE 1
+// DMX channels per pixel: 1 for 8 bit gray, 2 for 16 bit gray (coarse
+// channel first) or 3 for RGB
+#define ARTNET_CHANNELS_PER_PIXEL 1
+// without an ArtSync for this long frames are shown as they complete again
+#define ARTNET_SYNC_TIMEOUT_MS 4000
+// datagrams taken from the socket per loop() at most, so a flood cannot
+// hold the drawing task
+#define ARTNET_DRAIN_MAX 32
+
+struct ArtNetStats
+{
+    uint32_t packets = 0;   // ArtDmx for our universes
+    uint32_t ignored = 0;   // ArtDmx for other universes
+    uint32_t syncs = 0;
+    uint32_t polls = 0;
+    uint8_t queueDepth = 0;     // datagrams waiting at the last loop() that found any
+    uint8_t maxQueueDepth = 0;
+};
 
 class ArtNetPlugin : public Plugin {
 private:
     ArtnetWifi artnet;
 
+    uint16_t startUniverse = START_UNIVERSE;
+    uint8_t channelsPerPixel = ARTNET_CHANNELS_PER_PIXEL;
+    DmxFrame frame;
+    unsigned long lastSyncMs = 0;
+    bool synchronous = false;
+
+    void configure(uint16_t universe, uint8_t channels);
+    void onDmx(uint16_t universe, uint16_t length, const uint8_t *data);
+
 public:
+    ArtNetStats stats;
+
     void setup() override;
     void teardown() override;
     void loop() override;
+    void addStats(JsonObject object) override;
     const char* getName() const override;
-    static void onDmxFrame(uint16_t universe, uint16_t length, uint16_t outgoing, uint8_t* data);
     void websocketHook(DynamicJsonDocument &request) override;
 
 };
-
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PluginManager.h"
+#include "coroutine.h"
 
 class BreakoutPlugin : public Plugin
 {
@@ -38,6 +39,11 @@ private:
   uint8_t ballDelay;
   uint8_t score;
   unsigned long lastBallUpdate = 0;
+  unsigned long nextStepMs = 0;
+
+  // bricks are laid one per frame, kept across frames
+  Coroutine building;
+  uint8_t brick = 0;
 
   void resetLEDs();
   void initGame();
@@ -51,6 +57,7 @@ private:
 
 public:
   void setup() override;
-  void loop() override;
+  void tick(uint32_t now, uint32_t dt) override;
+  uint16_t getFramePeriod() const override;
   const char *getName() const override;
 };
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include "PluginManager.h"
+#include "ddpreceiver.h"
+#include "ingest.h"
 #if __has_include("AsyncUDP.h")
 #include "AsyncUDP.h"
 #define ASYNC_UDP_ENABLED
@@ -10,12 +13,22 @@ class DDPPlugin : public Plugin
 {
 private:
 #ifdef ASYNC_UDP_ENABLED
-  AsyncUDP *udp;
+    // Created once and kept. AsyncUDP may still dispatch a packet it queued
+    // before close(), the handler then finds listening false.
+    AsyncUDP *udp = nullptr;
 #endif
+    // written by teardown() on the drawing task, read by the UDP task
+    std::atomic<bool> listening{false};
+    // UDP handlers running right now
+    std::atomic<uint8_t> receiving{0};
+    DDPReceiver receiver;
+
+    void onPacket(const uint8_t *data, size_t length);
 
 public:
-  void setup() override;
-  void teardown() override;
-  void loop() override;
-  const char *getName() const override;
+    void setup() override;
+    void teardown() override;
+    void loop() override;
+    void addStats(JsonObject object) override;
+    const char *getName() const override;
 };
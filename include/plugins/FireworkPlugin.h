@@ -1,21 +1,29 @@
 #pragma once
 
 #include "PluginManager.h"
+#include "coroutine.h"
 
 class FireworkPlugin : public Plugin
 {
 private:
-  unsigned long previousMillis = 0;
   const long explosionDelay = 60;
   const long fadeDelay = 24;
   const long rocketDelay = 60;
-  const long explosionDuration = 500;
+  Canvas canvas;
+
+  // state of the show, kept across frames
+  Coroutine show;
+  int rocketX = 0;
+  int rocketY = 16;
+  int radius = 0;
+  int maxRadius = 0;
+  int fadeStep = 0;
 
   void drawExplosion(int x, int y, int maxRadius, int brightness);
-  void explode(int x, int y);
 
 public:
   void setup() override;
-  void loop() override;
+  void tick(uint32_t now, uint32_t dt) override;
+  uint16_t getFramePeriod() const override;
   const char *getName() const override;
 };
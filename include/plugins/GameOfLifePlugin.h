@@ -13,6 +13,7 @@ private:
 
 public:
   void setup() override;
-  void loop() override;
+  void tick(uint32_t now, uint32_t dt) override;
+  uint16_t getFramePeriod() const override;
   const char *getName() const override;
 };
@@ -6,14 +6,10 @@ class LinesPlugin : public Plugin
 {
 private:
   uint8_t count = 0;
-  std::vector<std::vector<int>> frames = {
-      {0xcc, 0xcc},
-      {0x66, 0x66},
-      {0x33, 0x33},
-      {0x99, 0x99}};
 
 public:
   void setup() override;
-  void loop() override;
+  void tick(uint32_t now, uint32_t dt) override;
+  uint16_t getFramePeriod() const override;
   const char *getName() const override;
 };
@@ -49,7 +49,6 @@ private:
       current_minute = 0,
       current_hour = 0;
 
-  void drawCharacter(int x, int y, std::vector<int> bits, int bitCount, uint8_t brightness = 255);
   byte getScreenIndex(byte x, byte y);
   void swapXdirection();
   void swapYdirection();
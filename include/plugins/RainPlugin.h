@@ -18,9 +18,11 @@ private:
   };
 
   Drop drops[RainPlugin::NUM_DROPS];
+  Canvas canvas;
 
 public:
   void setup() override;
-  void loop() override;
+  void tick(uint32_t now, uint32_t dt) override;
+  uint16_t getFramePeriod() const override;
   const char *getName() const override;
 };
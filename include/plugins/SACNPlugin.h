@@ -0,0 +1,21 @@
+#pragma once
+
+#include "PluginManager.h"
+#include "ingest.h"
+#include "sacnreceiver.h"
+
+class SACNPlugin : public Plugin
+{
+private:
+  uint16_t startUniverse = SACN_START_UNIVERSE;
+  uint8_t channelsPerPixel = SACN_CHANNELS_PER_PIXEL;
+  SACNReceiver receiver;
+
+public:
+  void setup() override;
+  void teardown() override;
+  void loop() override;
+  void addStats(JsonObject object) override;
+  void websocketHook(DynamicJsonDocument &request) override;
+  const char *getName() const override;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PluginManager.h"
+#include "coroutine.h"
 
 class SnakePlugin : public Plugin
 {
@@ -9,6 +10,7 @@ private:
   static const uint8_t LED_TYPE_ON = 1;
   static const uint8_t GAME_STATE_RUNNING = 1;
   static const uint8_t GAME_STATE_END = 2;
+  static const uint8_t GAME_STATE_DYING = 3;
 
   unsigned char gameState;
   unsigned char lastDirection = 0; // 0=unset 1=up 2=right 3=down 4 =left
@@ -17,6 +19,11 @@ private:
 
   uint8_t dot;
 
+  // state of the death animation, kept across frames
+  Coroutine dying;
+  uint8_t blink = 0;
+  size_t segment = 0;
+
   void initGame();
   void newDot();
   void findDirection();
@@ -25,6 +32,7 @@ private:
 
 public:
   void setup() override;
-  void loop() override;
+  void tick(uint32_t now, uint32_t dt) override;
+  uint16_t getFramePeriod() const override;
   const char *getName() const override;
 };
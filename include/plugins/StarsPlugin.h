@@ -6,18 +6,18 @@ struct Star
 {
   int x;
   int y;
-  int brightness;
-  unsigned long lastUpdateTime;
 };
 class StarsPlugin : public Plugin
 {
 private:
   int numStars = 25;
   Star stars[25];
+  Canvas canvas;
 
 public:
   void setup() override;
-  void loop() override;
+  void tick(uint32_t now, uint32_t dt) override;
+  uint16_t getFramePeriod() const override;
   void teardown() override;
   const char *getName() const override;
 };
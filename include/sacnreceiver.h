@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Arduino.h>
+#include "dmxframe.h"
+#if __has_include("lwip/sockets.h")
+#include "lwip/sockets.h"
+#define SACN_SOCKETS_ENABLED
+#endif
+
+#define SACN_PORT 5568
+#define SACN_START_UNIVERSE 1
+// DMX slots per pixel: 1 for 8 bit gray, 2 for 16 bit gray or 3 for RGB
+#define SACN_CHANNELS_PER_PIXEL 1
+// E1.31 network data loss timeout, for sources and synchronization
+#define SACN_TIMEOUT_MS 2500
+// datagrams taken from the socket per poll() at most
+#define SACN_DRAIN_MAX 32
+
+// E1.31 root layer
+#define SACN_ROOT_VECTOR_DATA 0x00000004
+#define SACN_ROOT_VECTOR_EXTENDED 0x00000008
+// framing layer
+#define SACN_FRAMING_VECTOR_DATA 0x00000002
+#define SACN_FRAMING_VECTOR_SYNC 0x00000001
+#define SACN_OPTION_PREVIEW 0x80
+#define SACN_OPTION_TERMINATED 0x40
+// root layer up to the framing vector, every packet kind starts with it
+#define SACN_MIN_PACKET_SIZE 44
+// offsets of a data packet, slot 0 is the start code
+#define SACN_DATA_HEADER_SIZE 126
+#define SACN_SYNC_PACKET_SIZE 49
+#define SACN_MAX_PACKET_SIZE (SACN_DATA_HEADER_SIZE + DMX_SLOTS)
+
+// the source a universe follows: the highest priority one seen lately
+struct SACNSource
+{
+  uint8_t cid[16];
+  uint8_t priority = 0;
+  uint8_t sequence = 0;
+  unsigned long lastMs = 0;
+  bool active = false;
+};
+
+struct SACNStats
+{
+  uint32_t packets = 0;        // data for our universes
+  uint32_t ignored = 0;        // other universes, preview data, other start codes
+  uint32_t malformed = 0;
+  uint32_t lowerPriority = 0;  // from a source below the one followed
+  uint32_t outOfOrder = 0;     // duplicate or late sequence number
+  uint32_t sourceChanges = 0;
+  uint32_t syncs = 0;
+  uint8_t queueDepth = 0;      // datagrams waiting at the last poll() that found any
+  uint8_t maxQueueDepth = 0;
+};
+
+// The E1.31 side of the sACN plugin: a UDP socket in the multicast groups
+// of its universes, source arbitration, sequence checks and universe
+// synchronization. Complete frames wait in frame. Works on any BSD socket
+// API, see test/test_sacn.
+class SACNReceiver
+{
+private:
+  int sock_ = -1;
+  // datagrams are parsed where they were received into
+  uint8_t packet_[SACN_MAX_PACKET_SIZE];
+
+  uint16_t startUniverse_ = SACN_START_UNIVERSE;
+  SACNSource sources_[DMX_FRAME_MAX_UNIVERSES];
+
+  // synchronization universe of the data followed, 0 for none
+  uint16_t syncAddress_ = 0;
+  uint16_t joinedSync_ = 0;
+  uint8_t syncSequence_ = 0;
+  unsigned long lastSyncMs_ = 0;
+
+  void join(uint16_t universe);
+  void leave(uint16_t universe);
+  void receive(size_t length);
+  void receiveData(size_t length);
+  void receiveSync(size_t length);
+  bool acceptSource(SACNSource &source, const uint8_t *cid, uint8_t priority, uint8_t sequence, unsigned long now);
+
+public:
+  DmxFrame frame;
+  SACNStats stats;
+
+  // binds port on all interfaces and joins the groups of the universes
+  bool open(uint16_t port = SACN_PORT);
+  void close();
+  // forgets sources and pending data, reopen to join the new groups
+  void configure(uint16_t universe, uint8_t channelsPerPixel);
+  // takes the datagrams waiting on the socket, complete frames are in frame
+  void poll();
+
+  uint16_t getStartUniverse() const;
+  uint16_t getSyncAddress() const;
+  // data waits for a sync while its universe gets them, without syncs for a
+  // while frames are shown as they complete
+  bool isSynchronous(unsigned long now) const;
+};
@@ -1,43 +1,152 @@
 #pragma once
 
 #include <Arduino.h>
+#include <atomic>
+#include <initializer_list>
 #include <vector>
 #include "PluginManager.h"
 #include "signs.h"
+#include "canvas.h"
+#include "textstrip.h"
 #include "constants.h"
 #include "storage.h"
+
+#define ALL_ROWS ((uint16_t)((1UL << ROWS) - 1))
+#define DIRTY_HISTORY 16 // generations getDirtyRows() can look back
+static_assert(ROWS <= 16, "row masks are 16 bit");
+
+// Layers are composited bottom to top into the frame that is shown. Plugins
+// draw the base layer through the regular drawing calls.
+enum Layer
+{
+  LAYER_BASE,
+  LAYER_STREAM,  // network pixel streams
+  LAYER_OVERLAY, // messages
+  LAYER_SYSTEM,  // status indicators
+  LAYER_UPDATE,  // OTA progress, covers everything below
+  LAYERS
+};
+
+enum BlendMode
+{
+  BLEND_REPLACE, // layer over what is below, opacity fades between both
+  BLEND_MAX,     // brighter pixel wins
+  BLEND_ADD,     // sum, stopping at 255
+  BLEND_MASK,    // below is only kept where the layer is lit, scaled by it
+};
+
+// refresh timing picked by Screen_::tuneRefresh() for this board
+struct RefreshProfile
+{
+  uint32_t intervalUs = 0; // base refresh tick
+  uint16_t grayLevels = 0;
+  uint16_t refreshHz = 0;
+  uint16_t renderUs = 0;   // worst measured refresh interrupt
+  uint16_t spiUs = 0;      // worst measured subframe transfer
+  uint8_t isrLoadPercent = 0;
+};
+
+#ifdef ENABLE_REFRESH_METRICS
+#define METRICS_BUCKETS 64
+
+// refresh interrupt statistics since boot or the last reset
+struct RefreshMetrics
+{
+  uint32_t ticks = 0;
+  uint32_t skippedTicks = 0;
+  uint32_t framesCommitted = 0;
+  uint32_t refreshHz = 0;
+  uint32_t minCycles = 0;
+  uint32_t avgCycles = 0;
+  uint32_t maxCycles = 0;
+  uint32_t p99Cycles = 0;
+  uint32_t avgSpiCycles = 0;
+};
+#endif
+
 class Screen_
 {
 private:
-  Screen_() = default;
+  Screen_();
 
-  volatile bool updating_ = false;
   uint8_t brightness_ = 255;
-  uint8_t renderBuffer_[ROWS * COLS];
-  uint8_t rotatedRenderBuffer_[ROWS * COLS];
+  // commit() encodes front_ for the refresh interrupt. All drawing goes to
+  // back_, a present copies it or the composite of all layers into the spare
+  // frame and flips.
+  uint8_t frames_[2][ROWS * COLS];
+  std::atomic<uint8_t *> front_;
+  uint8_t back_[ROWS * COLS] = {};
+  struct LayerState
+  {
+    BlendMode mode = BLEND_REPLACE;
+    uint8_t opacity = 255;
+    bool visible = false;
+  };
+  // back_ is the base layer, the others keep their own pixels
+  uint8_t layers_[LAYERS - 1][ROWS * COLS];
+  LayerState layerState_[LAYERS];
+  uint8_t composite_[ROWS * COLS];
+  // rows of composite_ that no longer match the layers
+  uint16_t staleRows_ = ALL_ROWS;
+  uint8_t frameDepth_ = 0;
+  volatile uint32_t refreshCount_ = 0;
+  volatile uint32_t isrCycles_ = 0;
+  // pixels of the front buffer that need more than one subframe to show
+  volatile uint16_t modulatedPixels_ = 0;
+  // generation n changed the rows in dirtyHistory_[n % DIRTY_HISTORY]
+  uint32_t generation_ = 0;
+  uint16_t dirtyHistory_[DIRTY_HISTORY] = {};
+  uint32_t persistedGeneration_ = UINT32_MAX;
+  // rows the spare subframe set has not been encoded with yet
+  uint16_t spareStaleRows_ = 0;
+  RefreshProfile refreshProfile_;
+  volatile uint16_t tuneSamples_ = 0;
+  volatile uint32_t tunePeakCycles_ = 0;
+  volatile uint32_t tuneSpiCycles_ = 0;
+  bool tunePending_ = false;
+
+#ifdef ENABLE_REFRESH_METRICS
+  struct TickMetrics
+  {
+    uint32_t ticks = 0;
+    uint32_t skippedTicks = 0;
+    uint32_t framesCommitted = 0;
+    uint32_t refreshHz = 0;
+    uint32_t minCycles = UINT32_MAX;
+    uint32_t maxCycles = 0;
+    uint64_t cycleSum = 0;
+    uint64_t spiCycleSum = 0;
+    uint32_t histogram[METRICS_BUCKETS] = {};
+    uint32_t lastTickUs = 0;
+    uint32_t windowStartUs = 0;
+    uint32_t windowRefreshes = 0;
+  };
+  TickMetrics metrics_;
+
+  ICACHE_RAM_ATTR void recordTick(uint32_t cycles, uint32_t spiCycles, uint32_t expectedUs);
+#endif
+  uint32_t commitCount_ = 0;
+  uint32_t commitsPerSecond_ = 0;
+  unsigned long commitWindowStart_ = 0;
   uint8_t cache_[ROWS * COLS];
-  uint8_t positions[ROWS * COLS] = {
-      0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
-      0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
-      0x27, 0x26, 0x25, 0x24, 0x23, 0x22, 0x21, 0x20, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
-      0x2f, 0x2e, 0x2d, 0x2c, 0x2b, 0x2a, 0x29, 0x28, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f,
-      0x4f, 0x4e, 0x4d, 0x4c, 0x4b, 0x4a, 0x49, 0x48, 0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f,
-      0x47, 0x46, 0x45, 0x44, 0x43, 0x42, 0x41, 0x40, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57,
-      0x67, 0x66, 0x65, 0x64, 0x63, 0x62, 0x61, 0x60, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77,
-      0x6f, 0x6e, 0x6d, 0x6c, 0x6b, 0x6a, 0x69, 0x68, 0x78, 0x79, 0x7a, 0x7b, 0x7c, 0x7d, 0x7e, 0x7f,
-      0x8f, 0x8e, 0x8d, 0x8c, 0x8b, 0x8a, 0x89, 0x88, 0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f,
-      0x87, 0x86, 0x85, 0x84, 0x83, 0x82, 0x81, 0x80, 0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
-      0xa7, 0xa6, 0xa5, 0xa4, 0xa3, 0xa2, 0xa1, 0xa0, 0xb0, 0xb1, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7,
-      0xaf, 0xae, 0xad, 0xac, 0xab, 0xaa, 0xa9, 0xa8, 0xb8, 0xb9, 0xba, 0xbb, 0xbc, 0xbd, 0xbe, 0xbf,
-      0xcf, 0xce, 0xcd, 0xcc, 0xcb, 0xca, 0xc9, 0xc8, 0xd8, 0xd9, 0xda, 0xdb, 0xdc, 0xdd, 0xde, 0xdf,
-      0xc7, 0xc6, 0xc5, 0xc4, 0xc3, 0xc2, 0xc1, 0xc0, 0xd0, 0xd1, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7,
-      0xe7, 0xe6, 0xe5, 0xe4, 0xe3, 0xe2, 0xe1, 0xe0, 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
-      0xef, 0xee, 0xed, 0xec, 0xeb, 0xea, 0xe9, 0xe8, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff};
+  TextStrip textStrip_;
+  // wiring + rotation map of the active rotation, see setCurrentRotation()
+  const uint8_t *panelMap_;
+  const uint8_t *panelPosition_;
+
+  uint8_t *layerPixels(Layer layer);
+  bool isLayered() const;
+  void compose(uint16_t rows);
+  void show();
+  void commit(uint16_t rows);
+  void markDirty(uint16_t rows);
+  void setModulatedPixels(uint16_t count);
+  void writePixel(int index, uint8_t value);
 
   static void onScreenTimer();
+  static void scheduleNextTick(uint32_t intervalUs);
+  static void wakeRefresh();
   ICACHE_RAM_ATTR void _render();
-  void rotate();
-  uint8_t *getRotatedRenderBuffer();
 
 public:
   static Screen_ &getInstance();
@@ -51,11 +160,52 @@ public:
   uint8_t getCurrentBrightness() const;
   void setBrightness(uint8_t brightness, bool shouldStore = false);
 
-  void beginUpdate() { updating_ = true; }
-  void endUpdate() { updating_ = false; }
+  // Drawing between beginFrame() and present() shows up as one frame, frames
+  // may be nested. Without an open frame every call is visible immediately.
+  void beginFrame();
+  void present(bool waitForRefresh = false);
+  // shows a frame drawn off-screen, replacing the whole render buffer
+  void present(const Canvas &canvas, bool waitForRefresh = false);
+  // blocks until the refresh has started showing the current front buffer
+  void waitForRefresh();
+  // Replaces the pixels of a layer and shows it, hidden layers are skipped
+  // when compositing. Drawing on the base layer carries on underneath.
+  void setLayer(Layer layer, const uint8_t *pixels, BlendMode mode = BLEND_REPLACE, uint8_t opacity = 255);
+  void setLayer(Layer layer, const Canvas &canvas, BlendMode mode = BLEND_REPLACE, uint8_t opacity = 255);
+  void setLayerBlend(Layer layer, BlendMode mode, uint8_t opacity = 255);
+  void hideLayer(Layer layer);
+  bool isLayerVisible(Layer layer) const;
+
+  uint32_t getCommitsPerSecond() const;
+  // CPU cycles spent in the last refresh interrupt
+  uint32_t getIsrCycles() const;
+  // bumped whenever a presented frame or single pixel write changes what is
+  // shown. getDirtyRows() returns a bitmask of the rows changed since the
+  // given generation, or all rows if it is too old to tell.
+  uint32_t getGeneration() const;
+  uint16_t getDirtyRows(uint32_t sinceGeneration) const;
+
+  // true while the frame is pure on/off and the refresh runs at keep-alive rate
+  bool isIdle() const;
+
+  // measures the refresh interrupt and SPI transfer over the next ticks,
+  // updateRefreshProfile() then picks the fastest interval and deepest gray
+  // levels that fit REFRESH_ISR_BUDGET_PERCENT and REFRESH_MIN_HZ. Both
+  // re-encode the subframes, drawing task only like every commit.
+  void tuneRefresh();
+  void updateRefreshProfile();
+  const RefreshProfile &getRefreshProfile() const;
+
+#ifdef ENABLE_REFRESH_METRICS
+  RefreshMetrics getRefreshMetrics() const;
+  void resetRefreshMetrics();
+#endif
 
   void setRenderBuffer(const uint8_t *renderBuffer, bool grays = false);
+  // the base layer plugins draw on
   uint8_t *getRenderBuffer();
+  // what the panel shows, all layers composited, see getGeneration()
+  const uint8_t *getShownFrame() const;
 
   void clear();
   void clearRect(int x, int y, int width, int height);
@@ -74,13 +224,14 @@ public:
 
   void drawLine(int x1, int y1, int x2, int y2, int ledStatus, uint8_t brightness = 255);
   void drawRectangle(int x, int y, int width, int height, bool fill, int ledStatus, uint8_t brightness = 255);
-  void drawCharacter(int x, int y, std::vector<int> bits, int bitCount, uint8_t brightness = 255);
-  void drawNumbers(int x, int y, std::vector<int> numbers, uint8_t brightness = 255);
-  void drawBigNumbers(int x, int y, std::vector<int> numbers, uint8_t brightness = 255);
+  // straight from the packed glyph bits, clear bits are drawn as off
+  void drawGlyph(int x, int y, const Glyph &glyph, uint8_t brightness = 255);
+  void drawNumbers(int x, int y, std::initializer_list<int> numbers, uint8_t brightness = 255);
+  void drawBigNumbers(int x, int y, std::initializer_list<int> numbers, uint8_t brightness = 255);
   void drawWeather(int x, int y, int weather, uint8_t brightness = 255);
-  std::vector<int> readBytes(std::vector<int> bytes);
 
-  void scrollText(std::string text, int delayTime = 30, uint8_t brightness = 255, uint8_t fontid = 0);
+  void scrollText(const std::string &text, int delayTime = 30, uint8_t brightness = 255, uint8_t fontid = 0);
+  void scrollText(const TextStrip &strip, int delayTime = 30, uint8_t brightness = 255);
   void scrollGraph(std::vector<int> graph = {}, int miny = 0, int maxy = 15, int delayTime = 60, uint8_t brightness = 255);
 };
 
@@ -1,28 +1,38 @@
 #pragma once
 
 #include <Arduino.h>
-#include <vector>
 #include "constants.h"
-#include <string>
 
-extern std::vector<int> letterU;
-extern std::vector<int> letterR;
-extern std::vector<int> degreeSymbol;
-extern std::vector<int> minusSymbol;
+#define FONT_SYSTEM 0
+#define FONT_BOLD_NUMBER 1
 
-extern std::vector<std::vector<int>> circleAnimation;
-extern std::vector<std::vector<int>> smallNumbers;
-extern std::vector<std::vector<int>> bigNumbers;
-extern std::vector<std::vector<int>> lineAnimation;
-extern std::vector<std::vector<int>> weatherIcons;
+// 1 bit per pixel in flash, rows of width bits packed back to back, MSB first
+struct Glyph
+{
+    const uint8_t *bits;
+    uint8_t width;
+    uint8_t height;
+};
 
-struct font
+struct Font
 {
-    std::string name;
-    int sizeX;
-    int sizeY;
-    int offset;
-    std::vector<std::vector<int>> data;
+    const char *name;
+    uint8_t sizeX;  // advance without the gap between characters
+    uint8_t sizeY;
+    uint8_t offset; // character code of the first glyph
+    uint8_t count;
+    const uint8_t *data; // count glyphs of sizeY rows, one byte per row
+
+    Glyph glyph(uint8_t character) const;
 };
 
-extern std::vector<font> fonts;
+extern const Glyph letterU;
+extern const Glyph letterR;
+extern const Glyph degreeSymbol;
+extern const Glyph minusSymbol;
+
+Glyph smallNumber(int digit);
+Glyph bigNumber(int digit);
+Glyph weatherIcon(int icon);
+// unknown ids fall back to the system font
+const Font &getFont(uint8_t id);
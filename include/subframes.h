@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Arduino.h>
+#include "constants.h"
+
+#ifdef ESP8266
+#define TIMER_INTERVAL_US 320 // timer1 ticks are 3.2us
+#else
+#define TIMER_INTERVAL_US 200
+#endif
+#define GRAY_LEVELS 64 // must be a power of two
+#define BCM_PLANES 6   // log2(GRAY_LEVELS)
+#define BCM_LSB_US 100 // display time of the least significant plane
+#define SUBFRAME_BYTES (ROWS * COLS / 8)
+
+// How Screen_ encodes gray values into the 1 bit frames the refresh
+// interrupt shifts out, and how long each of them stays latched. PWM shows
+// GRAY_LEVELS subframes of one base interval. BCM shows one bit-plane per
+// subframe, plane n for 2^n base intervals. Every gray shift halves the
+// gray levels. The firmware picks the mode at build time with
+// ENABLE_BCM_REFRESH, test/test_refresh runs both. Inline because the
+// refresh interrupt runs from IRAM.
+namespace Subframes
+{
+  enum Mode : uint8_t
+  {
+    PWM,
+    BCM,
+  };
+
+  constexpr int grayLevels(uint8_t shift)
+  {
+    return GRAY_LEVELS >> shift;
+  }
+
+  // base intervals value is lit per refresh, rounded up so even the dimmest
+  // values stay visible
+  constexpr int grayLevel(Mode mode, uint8_t value, uint8_t shift)
+  {
+    int level = (value + (1 << (2 + shift)) - 1) >> (2 + shift);
+    return mode == BCM && level > grayLevels(shift) - 1 ? grayLevels(shift) - 1 : level;
+  }
+
+  // subframes of one refresh
+  constexpr int count(Mode mode, uint8_t shift)
+  {
+    return mode == BCM ? BCM_PLANES - shift : grayLevels(shift);
+  }
+
+  // duration of one full refresh in base intervals
+  constexpr uint32_t refreshPeriods(Mode mode, uint8_t shift)
+  {
+    return mode == BCM ? grayLevels(shift) - 1 : grayLevels(shift);
+  }
+
+  // how long subframe stays latched
+  constexpr uint32_t intervalUs(Mode mode, uint32_t baseUs, int subframe)
+  {
+    return mode == BCM ? baseUs << subframe : baseUs;
+  }
+
+  // true if the pixel is neither off nor on in every subframe
+  constexpr bool needsModulation(Mode mode, uint8_t value, uint8_t shift)
+  {
+    return grayLevel(mode, value, shift) > 0 && grayLevel(mode, value, shift) < (int)refreshPeriods(mode, shift);
+  }
+
+  // sets or clears the bit of one shift register position in every subframe
+  inline void writePixel(Mode mode, uint8_t *subframes, int position, uint8_t value, uint8_t shift)
+  {
+    uint8_t *bits = subframes + (position >> 3);
+    uint8_t mask = 0x80 >> (position & 7);
+    int level = grayLevel(mode, value, shift);
+    int subframeCount = count(mode, shift);
+
+    for (int subframe = 0; subframe < subframeCount; subframe++, bits += SUBFRAME_BYTES)
+    {
+      bool lit = mode == BCM ? (level >> subframe) & 1 : subframe < level;
+      *bits = lit ? *bits | mask : *bits & ~mask;
+    }
+  }
+}
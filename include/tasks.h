@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Arduino.h>
+
+// HOST_TASKS builds the task code for the native env, on the threading
+// shim in test/host/freertos, see test/test_tasks
+#if defined(ESP32) || defined(HOST_TASKS)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <vector>
+
+// Task topology, highest priority first. WiFi and lwIP live on core 0 at
+// priority 18 and up, so rendering gets the other core where there is one
+// (the C3 has a single core and everything shares it).
+//
+//   task       core  prio  stack  work
+//   render     1     4     10000  commands, plugins, messages, screen commits
+//   async_tcp  0     3     lib    HTTP and websocket requests, websocket frames
+//   async_udp  0     3     lib    DDP packets
+//   loopTask   1     1     8192   control: button, scheduler, OTA, ws clients
+//   service    0     1     8192   weather and stock fetches, WiFi, heartbeat
+//
+// The render task sleeps until its next frame or a posted command, so the
+// control loop on the same core only waits while a frame is drawn. The
+// ingest tasks belong to AsyncTCP and AsyncUDP and are placed through
+// build flags in platformio.ini.
+#define RENDER_CORE (portNUM_PROCESSORS - 1)
+#define RENDER_PRIORITY 4
+#define RENDER_STACK 10000
+#define SERVICE_CORE 0
+#define SERVICE_PRIORITY 1
+#define SERVICE_STACK 8192
+
+// time a task spends awake, measured by the task itself around its work
+struct TaskLoad
+{
+  uint32_t windowStartUs = 0;
+  uint32_t awakeSinceUs = 0;
+  uint32_t busyUs = 0;
+  uint16_t permille = 0; // of the last full second
+
+  void wake()
+  {
+    awakeSinceUs = micros();
+  }
+
+  void sleep()
+  {
+    uint32_t now = micros();
+    busyUs += now - awakeSinceUs;
+    if (now - windowStartUs >= 1000000)
+    {
+      permille = (uint64_t)busyUs * 1000 / (now - windowStartUs);
+      busyUs = 0;
+      windowStartUs = now;
+    }
+  }
+};
+
+struct TaskEntry
+{
+  const char *name;
+  int8_t core;               // tskNO_AFFINITY if it may run on either
+  TaskHandle_t handle;       // looked up by name while nullptr
+  const TaskLoad *load;      // nullptr for tasks owned by libraries
+};
+
+class Tasks_
+{
+private:
+  Tasks_() = default;
+  std::vector<TaskEntry> tasks;
+
+public:
+  static Tasks_ &getInstance();
+
+  Tasks_(const Tasks_ &) = delete;
+  Tasks_ &operator=(const Tasks_ &) = delete;
+
+  // creates a task pinned to core and lists it
+  TaskHandle_t spawn(TaskFunction_t function, const char *name, uint32_t stack, UBaseType_t priority, int8_t core, const TaskLoad *load);
+  // lists a task created elsewhere, a library task is found by name once it runs
+  void add(const char *name, int8_t core, TaskHandle_t handle = nullptr, const TaskLoad *load = nullptr);
+  std::vector<TaskEntry> &getAll();
+};
+
+extern Tasks_ &Tasks;
+#endif
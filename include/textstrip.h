@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Arduino.h>
+#include <string>
+#include <vector>
+#include "constants.h"
+#include "signs.h"
+
+// A text rendered once into a strip of 1 bit columns, bit 0 being the top
+// row. Scrolling then only copies a COLS wide window out of it, whatever the
+// text length or font.
+class TextStrip
+{
+private:
+  std::vector<uint8_t> columns_;
+  std::string text_;
+  uint8_t fontId_ = 0;
+  uint8_t height_ = 0;
+  bool rendered_ = false;
+
+public:
+  // renders text unless it is already in the strip with the same font
+  void render(const std::string &text, uint8_t fontId = FONT_SYSTEM);
+  void clear();
+
+  int width() const
+  {
+    return columns_.size();
+  }
+
+  // draws the strip columns offset .. offset + COLS - 1 into a ROWS * COLS
+  // buffer at row y, columns outside the strip are drawn as off
+  void drawWindow(uint8_t *pixels, int offset, int y, uint8_t value = 255) const;
+};
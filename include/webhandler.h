@@ -1,12 +1,21 @@
 #pragma once
 
 #include "ESPAsyncWebServer.h"
+#include <ArduinoJson.h>
+#include "constants.h"
 
 void handleMessage(AsyncWebServerRequest *request);
 void handleMessageRemove(AsyncWebServerRequest *request);
 void handleGetInfo(AsyncWebServerRequest *request);
 void handleSetPlugin(AsyncWebServerRequest *request);
 void handleSetBrightness(AsyncWebServerRequest *request);
+void handleTuneRefresh(AsyncWebServerRequest *request);
+void handleSetIngest(AsyncWebServerRequest *request);
+
+#ifdef ENABLE_REFRESH_METRICS
+void addRefreshMetrics(JsonObject object);
+void handleGetMetrics(AsyncWebServerRequest *request);
+#endif
 void handleGetData(AsyncWebServerRequest *request);
 void handleSetSchedule(AsyncWebServerRequest *request);
 void handleClearSchedule(AsyncWebServerRequest *request);
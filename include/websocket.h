@@ -15,6 +15,8 @@ void onWsEvent(
     uint8_t *data,
     size_t len);
 void sendInfo();
+// drawing task only, reads the frames of the active animation plugin
+void sendAnimationFrames(uint32_t clientId);
 void initWebsocketServer(AsyncWebServer &server);
 void cleanUpClients();
 
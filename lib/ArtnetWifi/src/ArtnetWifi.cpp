@@ -66,6 +66,16 @@ uint16_t ArtnetWifi::read(void)
         sequence = artnetPacket[12];
         incomingUniverse = artnetPacket[14] | artnetPacket[15] << 8;
         dmxDataLength = artnetPacket[17] | artnetPacket[16] << 8;
+        // never hand out more than was received
+        if (packetSize < ART_DMX_START) {
+          return 0;
+        }
+        if (dmxDataLength > packetSize - ART_DMX_START) {
+          dmxDataLength = packetSize - ART_DMX_START;
+        }
+        if (dmxDataLength > ART_DMX_MAX) {
+          dmxDataLength = ART_DMX_MAX;
+        }
 
         if (artDmxCallback) (*artDmxCallback)(incomingUniverse, dmxDataLength, outgoingUniverse, artnetPacket + ART_DMX_START);
 #if !defined(ARDUINO_AVR_UNO_WIFI_REV2)
@@ -137,6 +147,62 @@ int ArtnetWifi::write(IPAddress ip)
   return Udp.endPacket();
 }
 
+int ArtnetWifi::writePollReply(uint16_t firstUniverse, uint8_t universes, const char *shortName, const char *longName)
+{
+  IPAddress ip = WiFi.localIP();
+  uint8_t mac[6];
+  WiFi.macAddress(mac);
+  int ok = 1;
+  uint8_t bindIndex = 1;
+
+  uint16_t universe = firstUniverse;
+  uint16_t last = firstUniverse + universes;
+  while (universe < last)
+  {
+    // the ports of one reply share net and sub-net, the upper 11 bits
+    uint8_t ports = 0;
+    while (ports < ART_POLL_REPLY_PORTS && universe + ports < last &&
+           ((universe + ports) >> 4) == (universe >> 4)) {
+      ports++;
+    }
+
+    uint8_t reply[ART_POLL_REPLY_SIZE] = {0};
+    memcpy(reply, artnetId, sizeof(artnetId));
+    reply[8] = ART_POLL_REPLY & 0xFF;
+    reply[9] = ART_POLL_REPLY >> 8;
+    for (int i = 0; i < 4; i++) {
+      reply[10 + i] = ip[i];
+      reply[207 + i] = ip[i];
+    }
+    reply[14] = ART_NET_PORT & 0xFF;
+    reply[15] = ART_NET_PORT >> 8;
+    reply[18] = (universe >> 8) & 0x7F;
+    reply[19] = (universe >> 4) & 0x0F;
+    reply[20] = 0x00;
+    reply[21] = 0xFF; // OemUnknown
+    strncpy((char *)reply + 26, shortName, 17);
+    strncpy((char *)reply + 44, longName, 63);
+    strncpy((char *)reply + 108, "#0001 [0000] ok", 63);
+    reply[173] = ports;
+    for (int i = 0; i < ports; i++) {
+      reply[174 + i] = 0x80; // output from Art-Net
+      reply[182 + i] = 0x80; // data is being output
+      reply[190 + i] = (universe + i) & 0x0F;
+    }
+    reply[200] = 0x00; // StNode
+    memcpy(reply + 201, mac, 6);
+    reply[211] = bindIndex++;
+    reply[212] = 0x08; // 15 bit port-address
+
+    Udp.beginPacket(senderIp, ART_NET_PORT);
+    Udp.write(reply, ART_POLL_REPLY_SIZE);
+    ok &= Udp.endPacket();
+
+    universe += ports;
+  }
+  return ok;
+}
+
 void ArtnetWifi::setByte(uint16_t pos, uint8_t value)
 {
   if (pos > 512) {
@@ -53,6 +53,7 @@ THE SOFTWARE.
 #define ART_NET_PORT 6454
 // Opcodes
 #define ART_POLL 0x2000
+#define ART_POLL_REPLY 0x2100
 #define ART_DMX 0x5000
 #define ART_SYNC 0x5200
 // Buffers
@@ -60,6 +61,9 @@ THE SOFTWARE.
 // Packet
 #define ART_NET_ID "Art-Net"
 #define ART_DMX_START 18
+#define ART_DMX_MAX 512
+#define ART_POLL_REPLY_SIZE 239
+#define ART_POLL_REPLY_PORTS 4
 
 #define DMX_FUNC_PARAM uint16_t universe, uint16_t length, uint8_t sequence, uint8_t* data
 #if !defined(ARDUINO_AVR_UNO_WIFI_REV2)
@@ -77,6 +81,9 @@ public:
   int write(void);
   int write(IPAddress ip);
   void setByte(uint16_t pos, uint8_t value);
+  /* answers the last ArtPoll with one reply per 4 output universes,
+     starting at firstUniverse (15 bit port-address). returns 1 for Ok */
+  int writePollReply(uint16_t firstUniverse, uint8_t universes, const char *shortName, const char *longName);
   void printPacketHeader(void);
   void printPacketContent(void);
 
@@ -88,6 +95,12 @@ public:
     return artnetPacket + ART_DMX_START;
   }
 
+  /* size of the datagram taken by the last read(), 0 if none was waiting */
+  inline uint16_t getPacketSize(void)
+  {
+    return packetSize;
+  }
+
   inline uint16_t getOpcode(void)
   {
     return opcode;
@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+import socket
+import argparse
+import struct
+import time
+import uuid
+
+WIDTH = 16
+HEIGHT = 16
+
+PORT = 5568
+ACN_IDENTIFIER = b'ASC-E1.17\x00\x00\x00'
+VECTOR_ROOT_DATA = 0x04
+VECTOR_ROOT_EXTENDED = 0x08
+VECTOR_FRAMING_DATA = 0x02
+VECTOR_FRAMING_SYNC = 0x01
+OPTION_TERMINATED = 0x40
+DMX_SLOTS = 512
+
+
+def flags_length(length):
+    """PDU flags and length field"""
+    return 0x7000 | length
+
+
+def create_frame(pixels=None, channels=1):
+    """Slot data of a frame with specified pixels or all off"""
+    data = bytearray([0] * (WIDTH * HEIGHT * channels))
+
+    # Set specified pixels
+    if pixels:
+        for x, y, brightness in pixels:
+            if 0 <= x < WIDTH and 0 <= y < HEIGHT and 0 <= brightness <= 255:
+                index = (y * WIDTH + x) * channels
+                if channels == 2:
+                    # 16 bit gray, high byte first
+                    data[index:index + 2] = [brightness, brightness]
+                else:
+                    data[index:index + channels] = [brightness] * channels
+    return data
+
+
+def root_layer(cid, vector, length):
+    """Preamble and root layer for a framing layer of length bytes"""
+    packet = bytearray(struct.pack('>HH', 0x0010, 0x0000))
+    packet.extend(ACN_IDENTIFIER)
+    packet.extend(struct.pack('>HI', flags_length(22 + length), vector))
+    packet.extend(cid)
+    return packet
+
+
+def create_packet(cid, universe, slots, sequence=0, priority=100, sync=0,
+                  terminated=False, name='sacn.py'):
+    """Create an E1.31 data packet carrying slots for universe"""
+    dmp = struct.pack('>HBBHHH', flags_length(11 + len(slots)), 0x02, 0xA1,
+                      0x0000, 0x0001, len(slots) + 1) + b'\x00' + bytes(slots)
+    options = OPTION_TERMINATED if terminated else 0
+    framing = struct.pack('>HI64sBHBBH', flags_length(77 + len(dmp)), VECTOR_FRAMING_DATA,
+                          name.encode()[:63], priority, sync, sequence & 0xFF, options, universe)
+    packet = root_layer(cid, VECTOR_ROOT_DATA, len(framing) + len(dmp))
+    packet.extend(framing)
+    packet.extend(dmp)
+    return packet
+
+
+def create_sync(cid, address, sequence=0):
+    """Create an E1.31 synchronization packet for address"""
+    framing = struct.pack('>HIBHH', flags_length(11), VECTOR_FRAMING_SYNC,
+                          sequence & 0xFF, address, 0x0000)
+    packet = root_layer(cid, VECTOR_ROOT_EXTENDED, len(framing))
+    packet.extend(framing)
+    return packet
+
+
+def create_packets(cid, data, universe, sequence=0, priority=100, sync=0):
+    """Split a frame over universes of 512 slots, as many pixels as fit whole"""
+    channels = len(data) // (WIDTH * HEIGHT)
+    step = DMX_SLOTS // channels * channels
+    packets = []
+    for index, offset in enumerate(range(0, len(data), step)):
+        packets.append(create_packet(cid, universe + index, data[offset:offset + step],
+                                     sequence, priority, sync))
+    return packets
+
+
+def address(ip, universe):
+    """Unicast target or the multicast group of universe"""
+    if ip:
+        return (ip, PORT)
+    return (f'239.255.{universe >> 8}.{universe & 0xFF}', PORT)
+
+
+def send_packets(sock, ip, universe, packets, verbose=True):
+    """Send packets, the n-th one to universe + n"""
+    for index, packet in enumerate(packets):
+        target = address(ip, universe + index)
+        sock.sendto(packet, target)
+        if verbose:
+            print(f"Sent sACN packet to {target[0]}:{target[1]}, {len(packet)} bytes")
+
+
+def stream(sock, args):
+    """Moving test pattern, optionally synchronized and from a second source
+    that takes over at a higher priority and hands back by terminating"""
+    cid = uuid.uuid4().bytes
+    second = uuid.uuid4().bytes
+    sequence = second_sequence = sync_sequence = 0
+    interval = 1.0 / args.fps
+    start = time.time()
+    for frame in range(args.frames):
+        pixels = [(x, y, 255 if (x + y + frame) % 8 == 0 else 0)
+                  for x in range(WIDTH) for y in range(HEIGHT)]
+        data = create_frame(pixels, args.channels)
+        send_packets(sock, args.ip, args.universe,
+                     create_packets(cid, data, args.universe, sequence, args.priority, args.sync),
+                     verbose=False)
+        sequence += 1
+
+        # the middle third of the stream comes from a brighter source as well
+        third = args.frames // 3
+        if args.second_source and third <= frame < 2 * third:
+            inverted = bytearray(255 - value for value in data)
+            last = frame == 2 * third - 1
+            packets = [create_packet(second, args.universe + index, packet[126:],
+                                     second_sequence, args.priority + 1, args.sync, terminated=last)
+                       for index, packet in enumerate(create_packets(second, inverted, args.universe))]
+            send_packets(sock, args.ip, args.universe, packets, verbose=False)
+            second_sequence += 1
+
+        if args.sync:
+            sock.sendto(create_sync(cid, args.sync, sync_sequence), address(args.ip, args.sync))
+            sync_sequence += 1
+        time.sleep(max(0, start + (frame + 1) * interval - time.time()))
+    print(f"Sent {args.frames} frames")
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Send E1.31 (sACN) packets to control LED matrix')
+    parser.add_argument('--ip', help='IP address of the display, multicast if omitted')
+    parser.add_argument('--universe', type=int, default=1, help='First universe of the panel')
+    parser.add_argument('--channels', type=int, default=1, choices=[1, 2, 3],
+                       help='Slots per pixel: 1 gray, 2 16 bit gray, 3 RGB')
+    parser.add_argument('--priority', type=int, default=100, help='Source priority (0-200)')
+    parser.add_argument('--sync', type=int, default=0, metavar='UNIVERSE',
+                       help='Synchronization universe, 0 for none')
+    parser.add_argument('--clear', action='store_true', help='Clear all pixels')
+    parser.add_argument('--fill', type=int, metavar='BRIGHTNESS',
+                       help='Fill all pixels with specified brightness (0-255)')
+    parser.add_argument('--pixel', nargs=3, type=int, action='append',
+                       metavar=('X', 'Y', 'BRIGHTNESS'),
+                       help='Set pixel at X,Y to brightness (can be used multiple times)')
+    parser.add_argument('--stream', action='store_true', help='Stream a moving test pattern')
+    parser.add_argument('--fps', type=float, default=30, help='Frames per second when streaming')
+    parser.add_argument('--frames', type=int, default=300, help='Number of frames to stream')
+    parser.add_argument('--second-source', action='store_true',
+                       help='Let a second source of higher priority take over mid stream')
+
+    args = parser.parse_args()
+
+    if not 1 <= args.universe <= 63999:
+        parser.error("Universe must be between 1 and 63999")
+    if not 0 <= args.priority <= 199:
+        parser.error("Priority must be between 0 and 199")
+
+    # Validate fill brightness
+    if args.fill is not None and not 0 <= args.fill <= 255:
+        parser.error("Fill brightness must be between 0 and 255")
+
+    # Validate pixel coordinates and brightness
+    pixels = []
+    if args.pixel:
+        for x, y, brightness in args.pixel:
+            if not (0 <= x < WIDTH and 0 <= y < HEIGHT):
+                parser.error(f"Invalid coordinates: {x},{y} (must be 0-15)")
+            if not (0 <= brightness <= 255):
+                parser.error(f"Invalid brightness: {brightness} (must be 0-255)")
+            pixels.append((x, y, brightness))
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_TTL, 1)
+    try:
+        if args.stream:
+            stream(sock, args)
+            return
+
+        # Create appropriate packets
+        if args.fill is not None:
+            pixels = [(x, y, args.fill) for x in range(WIDTH) for y in range(HEIGHT)]
+
+        cid = uuid.uuid4().bytes
+        packets = create_packets(cid, create_frame(pixels, args.channels), args.universe,
+                                 priority=args.priority, sync=args.sync)
+        send_packets(sock, args.ip, args.universe, packets)
+        if args.sync:
+            sock.sendto(create_sync(cid, args.sync), address(args.ip, args.sync))
+    except Exception as e:
+        print(f"Error: {e}")
+    finally:
+        sock.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -1,5 +1,6 @@
 #include "PluginManager.h"
 #include "scheduler.h"
+#include "commands.h"
 
 Plugin::Plugin() : id(-1) {}
 
@@ -16,13 +17,38 @@ int Plugin::getId() const
 void Plugin::teardown() {}
 void Plugin::loop() {}
 void Plugin::websocketHook(DynamicJsonDocument &request) {}
+void Plugin::addStats(JsonObject object) {}
+
+void Plugin::tick(uint32_t now, uint32_t dt)
+{
+    loop();
+}
+
+uint16_t Plugin::getFramePeriod() const
+{
+    return 0;
+}
+
+uint32_t Plugin::getFrameBudget() const
+{
+    uint16_t period = getFramePeriod();
+    return period > 0 ? period * 1000UL : SELF_PACED_BUDGET_US;
+}
 
 PluginManager::PluginManager() : nextPluginId(1) {}
 
 void PluginManager::init()
 {
     Screen.clear();
-    std::vector<Plugin *> &allPlugins = pluginManager.getAllPlugins();
+#ifdef ENABLE_STORAGE
+    storage.begin("led-wall", false);
+    if (storage.isKey("hung_plugin"))
+    {
+        blockedPlugin = storage.getString("hung_plugin").c_str();
+        storage.remove("hung_plugin");
+    }
+    storage.end();
+#endif
 
     activatePersistedPlugin();
 }
@@ -85,11 +111,16 @@ int PluginManager::addPlugin(Plugin *plugin)
 
 void PluginManager::setActivePlugin(const char *pluginName)
 {
+    if (blockedPlugin == pluginName)
+    {
+        return;
+    }
+
     if (activePlugin)
     {
         activePlugin->teardown();
-        delay(100);
         activePlugin = nullptr;
+        publishSnapshot();
     }
 
     for (Plugin *plugin : plugins)
@@ -98,7 +129,11 @@ void PluginManager::setActivePlugin(const char *pluginName)
         {
             Screen.clear();
             activePlugin = plugin;
+            activePlugin->frameStats = FrameStats();
             activePlugin->setup();
+            // first frame right away
+            nextFrameUs = lastTickUs = micros();
+            publishSnapshot();
             break;
         }
     }
@@ -124,13 +159,156 @@ void PluginManager::setupActivePlugin()
     }
 }
 
-void PluginManager::runActivePlugin()
+uint32_t PluginManager::runActivePlugin()
+{
+    if (!activePlugin || currentStatus == UPDATE ||
+        currentStatus == LOADING || currentStatus == WSBINARY)
+    {
+        return SELF_PACED_PERIOD_US;
+    }
+
+    FrameStats &stats = activePlugin->frameStats;
+    uint32_t period = (activePlugin->getFramePeriod() * 1000UL) << stats.demotions;
+    uint32_t now = micros();
+
+    if (period > 0)
+    {
+        int32_t early = (int32_t)(nextFrameUs - now);
+        if (early > 0)
+        {
+            return early;
+        }
+
+        uint32_t late = -early;
+        if (late >= period)
+        {
+            // skip the frames that are already over instead of catching up
+            stats.deadlineMisses += late / period;
+            nextFrameUs += late / period * period;
+        }
+        stats.maxLateUs = max(stats.maxLateUs, late);
+        stats.avgLateUs = stats.avgLateUs - stats.avgLateUs / 8 + late / 8;
+        nextFrameUs += period;
+    }
+
+    bool framed = period > 0;
+    tickStartedMs = framed ? millis() : 0;
+    activePlugin->tick(now, now - lastTickUs);
+    tickStartedMs = 0;
+    lastTickUs = now;
+    stats.frames++;
+    checkBudget(micros() - now, framed);
+    if (millis() - lastSnapshotMs >= PLUGIN_SNAPSHOT_MS)
+    {
+        publishSnapshot();
+    }
+
+    if (!framed)
+    {
+        return SELF_PACED_PERIOD_US << stats.demotions;
+    }
+    int32_t remaining = (int32_t)(nextFrameUs - micros());
+    return remaining > 0 ? remaining : 0;
+}
+
+void PluginManager::checkBudget(uint32_t tookUs, bool framed)
 {
-    if (activePlugin && currentStatus != UPDATE &&
-        currentStatus != LOADING && currentStatus != WSBINARY)
+    FrameStats &stats = activePlugin->frameStats;
+    stats.maxTickUs = max(stats.maxTickUs, tookUs);
+    stats.avgTickUs = stats.avgTickUs - stats.avgTickUs / 8 + tookUs / 8;
+
+    if (tookUs <= activePlugin->getFrameBudget())
+    {
+        stats.strikes -= stats.strikes > 0;
+        return;
+    }
+
+    stats.overruns++;
+    activePlugin->overruns++;
+    if (!framed)
+    {
+        return;
+    }
+    stats.strikes += OVERRUN_STRIKES;
+    if (stats.strikes < DEMOTE_STRIKES)
+    {
+        return;
+    }
+
+    stats.strikes = 0;
+    if (stats.demotions < MAX_DEMOTIONS)
+    {
+        stats.demotions++;
+        Serial.printf("[PLUGIN] %s over budget, frame period x%d\n", activePlugin->getName(), 1 << stats.demotions);
+    }
+    else
+    {
+        Serial.printf("[PLUGIN] %s keeps overrunning, switching\n", activePlugin->getName());
+        Commands.post(CMD_NEXT_PLUGIN);
+    }
+}
+
+void PluginManager::publishSnapshot()
+{
+    lastSnapshotMs = millis();
+
+    // built aside, readers only retry while it is copied
+    PluginSnapshot next;
+    if (activePlugin)
     {
-        activePlugin->loop();
+        next.id = activePlugin->getId();
+        next.periodMs = activePlugin->getFramePeriod();
+        next.budgetUs = activePlugin->getFrameBudget();
+        next.frameStats = activePlugin->frameStats;
+        StaticJsonDocument<PLUGIN_STATS_SIZE> stats;
+        activePlugin->addStats(stats.to<JsonObject>());
+        serializeJson(stats, next.stats, sizeof(next.stats));
     }
+
+    uint32_t sequence = snapshotSequence.load(std::memory_order_relaxed);
+    snapshotSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    snapshot = next;
+    snapshotSequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool PluginManager::getSnapshot(PluginSnapshot &copy) const
+{
+    for (int attempt = 0; attempt < 8; attempt++)
+    {
+        uint32_t sequence = snapshotSequence.load(std::memory_order_acquire);
+        if (sequence & 1)
+        {
+            // a copy is a few us
+            delayMicroseconds(5);
+            continue;
+        }
+        copy = snapshot;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (snapshotSequence.load(std::memory_order_relaxed) == sequence)
+        {
+            return copy.id >= 0;
+        }
+    }
+    return false;
+}
+
+void PluginManager::checkWatchdog()
+{
+    uint32_t startedMs = tickStartedMs;
+    Plugin *plugin = activePlugin;
+    if (!startedMs || !plugin || millis() - startedMs < PLUGIN_HANG_MS)
+    {
+        return;
+    }
+
+    Serial.printf("[PLUGIN] %s hangs, restarting\n", plugin->getName());
+#ifdef ENABLE_STORAGE
+    storage.begin("led-wall", false);
+    storage.putString("hung_plugin", plugin->getName());
+    storage.end();
+#endif
+    ESP.restart();
 }
 
 Plugin *PluginManager::getActivePlugin() const
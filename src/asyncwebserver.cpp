@@ -84,6 +84,11 @@ void initWebServer()
 
   // Handle API request to set the brightness (0..255);
   server.on("/api/brightness", HTTP_PATCH, [=](AsyncWebServerRequest *req){ if(!authGuard(req)) { req->send(401, "text/plain", "Unauthorized"); return;} handleSetBrightness(req); });
+  server.on("/api/ingest", HTTP_PATCH, [=](AsyncWebServerRequest *req){ if(!authGuard(req)) { req->send(401, "text/plain", "Unauthorized"); return;} handleSetIngest(req); });
+  server.on("/api/refresh/tune", HTTP_POST, [=](AsyncWebServerRequest *req){ if(!authGuard(req)) { req->send(401, "text/plain", "Unauthorized"); return;} handleTuneRefresh(req); });
+#ifdef ENABLE_REFRESH_METRICS
+  server.on("/api/metrics", HTTP_GET, [=](AsyncWebServerRequest *req){ if(!authGuard(req)) { req->send(401, "text/plain", "Unauthorized"); return;} handleGetMetrics(req); });
+#endif
   server.on("/api/data", HTTP_GET, [=](AsyncWebServerRequest *req){ if(!authGuard(req)) { req->send(401, "text/plain", "Unauthorized"); return;} handleGetData(req); });
 
   // Scheduler
@@ -0,0 +1,98 @@
+#include "canvas.h"
+
+void blitGlyph(uint8_t *pixels, int x, int y, const uint8_t *bits, int width, int height, uint8_t value, bool transparent)
+{
+  // clip the glyph rectangle once, then walk the visible part only
+  int fromX = max(0, -x);
+  int toX = min(width, COLS - x);
+  int fromY = max(0, -y);
+  int toY = min(height, ROWS - y);
+
+  for (int row = fromY; row < toY; row++)
+  {
+    uint8_t *pixel = pixels + (y + row) * COLS + x + fromX;
+    int bit = row * width + fromX;
+    for (int col = fromX; col < toX; col++, bit++, pixel++)
+    {
+      if (pgm_read_byte(bits + (bit >> 3)) & (0x80 >> (bit & 7)))
+      {
+        *pixel = value;
+      }
+      else if (!transparent)
+      {
+        *pixel = 0;
+      }
+    }
+  }
+}
+
+void Canvas::fillRect(int x, int y, int width, int height, uint8_t value)
+{
+  if (y < 0)
+  {
+    height += y;
+    y = 0;
+  }
+  height = min(height, ROWS - y);
+  for (int row = y; row < y + height; row++)
+  {
+    fillSpan(x, row, width, value);
+  }
+}
+
+void Canvas::drawRect(int x, int y, int width, int height, uint8_t value)
+{
+  if (width <= 0 || height <= 0)
+  {
+    return;
+  }
+  drawHLine(x, x + width - 1, y, value);
+  drawHLine(x, x + width - 1, y + height - 1, value);
+  // up to two rows high the top and bottom edges are the whole rectangle,
+  // drawVLine() would swap the empty range and draw outside
+  if (height > 2)
+  {
+    drawVLine(x, y + 1, y + height - 2, value);
+    drawVLine(x + width - 1, y + 1, y + height - 2, value);
+  }
+}
+
+void Canvas::drawLine(int x1, int y1, int x2, int y2, uint8_t value)
+{
+  if (y1 == y2)
+  {
+    drawHLine(x1, x2, y1, value);
+    return;
+  }
+  if (x1 == x2)
+  {
+    drawVLine(x1, y1, y2, value);
+    return;
+  }
+
+  int dx = abs(x2 - x1);
+  int sx = x1 < x2 ? 1 : -1;
+  int dy = -abs(y2 - y1);
+  int sy = y1 < y2 ? 1 : -1;
+  int error = dx + dy;
+
+  for (;;)
+  {
+    setPixel(x1, y1, value);
+    if (x1 == x2 && y1 == y2)
+    {
+      break;
+    }
+    int error2 = 2 * error;
+    if (error2 >= dy)
+    {
+      error += dy;
+      x1 += sx;
+    }
+    if (error2 <= dx)
+    {
+      error += dx;
+      y1 += sy;
+    }
+  }
+}
@@ -0,0 +1,178 @@
+#include "commands.h"
+#include "ingest.h"
+#include "messages.h"
+#include "scheduler.h"
+#include "websocket.h"
+
+Commands_ &Commands_::getInstance()
+{
+  static Commands_ instance;
+  return instance;
+}
+
+Commands_::Commands_()
+{
+  for (uint32_t i = 0; i < COMMAND_QUEUE_SIZE; i++)
+  {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool Commands_::post(CommandType type, int32_t value, void *payload)
+{
+  Command command;
+  command.type = type;
+  command.value = value;
+  command.payload = payload;
+
+  uint32_t position = head_.load(std::memory_order_relaxed);
+  Slot *slot;
+  for (;;)
+  {
+    slot = &slots_[position & (COMMAND_QUEUE_SIZE - 1)];
+    int32_t lag = (int32_t)(slot->sequence.load(std::memory_order_acquire) - position);
+    if (lag == 0)
+    {
+      // claim the position, another producer may have been faster
+      if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    else if (lag < 0)
+    {
+      // the consumer has not taken the command of the previous round yet
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      release(command);
+      return false;
+    }
+    else
+    {
+      position = head_.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->command = command;
+  slot->sequence.store(position + 1, std::memory_order_release);
+
+  wake();
+  return true;
+}
+
+void Commands_::apply()
+{
+  for (;;)
+  {
+    Slot &slot = slots_[tail_ & (COMMAND_QUEUE_SIZE - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != tail_ + 1)
+    {
+      return;
+    }
+    Command command = slot.command;
+    slot.sequence.store(tail_ + COMMAND_QUEUE_SIZE, std::memory_order_release);
+    tail_++;
+
+    execute(command);
+    release(command);
+  }
+}
+
+uint32_t Commands_::getDropped() const
+{
+  return dropped_.load(std::memory_order_relaxed);
+}
+
+void Commands_::wake()
+{
+#ifdef ESP32
+  if (consumer_)
+  {
+    xTaskNotifyGive(consumer_);
+  }
+#endif
+}
+
+#ifdef ESP32
+void Commands_::setConsumer(TaskHandle_t task)
+{
+  consumer_ = task;
+}
+#endif
+
+void Commands_::release(Command &command)
+{
+  switch (command.type)
+  {
+  case CMD_PLUGIN_EVENT:
+    delete static_cast<DynamicJsonDocument *>(command.payload);
+    break;
+  case CMD_ADD_MESSAGE:
+    delete static_cast<Message *>(command.payload);
+    break;
+  case CMD_INGEST_SETTINGS:
+    delete static_cast<IngestSettings *>(command.payload);
+    break;
+  default:
+    break;
+  }
+  command.payload = nullptr;
+}
+
+void Commands_::execute(Command &command)
+{
+  switch (command.type)
+  {
+  case CMD_SET_PLUGIN:
+    pluginManager.setActivePluginById(command.value);
+#ifdef ENABLE_SERVER
+    sendInfo();
+#endif
+    break;
+  case CMD_NEXT_PLUGIN:
+    pluginManager.activateNextPlugin();
+    break;
+  case CMD_PERSISTED_PLUGIN:
+    pluginManager.activatePersistedPlugin();
+    break;
+  case CMD_PERSIST_PLUGIN:
+    pluginManager.persistActivePlugin();
+    break;
+  case CMD_BRIGHTNESS:
+    Screen.setBrightness(command.value, true);
+    break;
+  case CMD_ROTATE:
+    Screen.setCurrentRotation((Screen.currentRotation + command.value) % 4, true);
+    break;
+  case CMD_TUNE_REFRESH:
+    Screen.tuneRefresh();
+    break;
+  case CMD_PLUGIN_EVENT:
+    if (pluginManager.getActivePlugin())
+    {
+      pluginManager.getActivePlugin()->websocketHook(*static_cast<DynamicJsonDocument *>(command.payload));
+    }
+    break;
+  case CMD_ADD_MESSAGE:
+  {
+    Message *msg = static_cast<Message *>(command.payload);
+    Messages.add(msg->text, msg->repeat, msg->id, msg->delay, msg->graph, msg->miny, msg->maxy, command.value);
+    break;
+  }
+  case CMD_REMOVE_MESSAGE:
+    Messages.remove(command.value);
+    break;
+  case CMD_SCROLL_MESSAGES:
+    Messages.scroll();
+    break;
+  case CMD_INGEST_SETTINGS:
+    Ingest.configure(*static_cast<IngestSettings *>(command.payload));
+    break;
+  case CMD_SEND_ANIMATION:
+#ifdef ENABLE_SERVER
+    sendAnimationFrames(command.value);
+#endif
+    break;
+  }
+}
+
+Commands_ &Commands = Commands.getInstance();
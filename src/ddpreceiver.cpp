@@ -0,0 +1,173 @@
+#include "ddpreceiver.h"
+
+namespace
+{
+  inline uint16_t read16(const uint8_t *data)
+  {
+    return data[0] << 8 | data[1];
+  }
+
+  inline uint32_t read32(const uint8_t *data)
+  {
+    return (uint32_t)data[0] << 24 | (uint32_t)data[1] << 16 | data[2] << 8 | data[3];
+  }
+}
+
+void DDPReceiver::reset()
+{
+  memset(channels_, 0, sizeof(channels_));
+  lastSequence_ = 0;
+  hasTimecode_ = false;
+  stats = DDPStats();
+  windowStartMs_ = millis();
+  windowPackets_ = windowFrames_ = 0;
+}
+
+bool DDPReceiver::receive(const uint8_t *data, size_t length)
+{
+  unsigned long now = millis();
+  stats.packets++;
+  windowPackets_++;
+  countRates(now);
+
+  if (length < DDP_HEADER_SIZE)
+  {
+    stats.malformed++;
+    return false;
+  }
+
+  uint8_t flags = data[0];
+  uint8_t sequence = data[1] & 0x0F;
+  uint8_t type = data[2];
+  uint8_t id = data[3];
+  uint32_t offset = read32(data + 4);
+  uint16_t dataLength = read16(data + 8);
+  size_t headerSize = DDP_HEADER_SIZE;
+  uint32_t timecode = 0;
+
+  if ((flags & DDP_VERSION_MASK) != DDP_VERSION_1 || (flags & DDP_FLAG_QUERY))
+  {
+    stats.malformed++;
+    return false;
+  }
+  if (flags & DDP_FLAG_TIMECODE)
+  {
+    if (length < DDP_HEADER_SIZE + DDP_TIMECODE_SIZE)
+    {
+      stats.malformed++;
+      return false;
+    }
+    timecode = read32(data + DDP_HEADER_SIZE);
+    headerSize += DDP_TIMECODE_SIZE;
+  }
+  if (id != DDP_ID_DISPLAY && id != 0)
+  {
+    stats.malformed++;
+    return false;
+  }
+
+  uint8_t pixelSize;
+  switch (type)
+  {
+  case DDP_TYPE_UNDEFINED:
+  case DDP_TYPE_RGB8:
+    pixelSize = 3;
+    break;
+  case DDP_TYPE_GRAY8:
+    pixelSize = 1;
+    break;
+  default:
+    stats.malformed++;
+    return false;
+  }
+  if (dataLength > length - headerSize)
+  {
+    stats.malformed++;
+    return false;
+  }
+
+  if (!acceptSequence(sequence, now))
+  {
+    stats.outOfOrder++;
+    return false;
+  }
+
+  // channels past the panel are not ours, a chained sender may use them
+  if (pixelSize != bytesPerPixel_)
+  {
+    bytesPerPixel_ = pixelSize;
+    memset(channels_, 0, sizeof(channels_));
+  }
+  uint32_t size = getFrameSize();
+  if (offset < size)
+  {
+    memcpy(channels_ + offset, data + headerSize, min((uint32_t)dataLength, size - offset));
+  }
+
+  if (!(flags & DDP_FLAG_PUSH))
+  {
+    return false;
+  }
+  if (flags & DDP_FLAG_TIMECODE)
+  {
+    if (hasTimecode_ && (int32_t)(timecode - lastTimecode_) < 0)
+    {
+      stats.staleFrames++;
+      return false;
+    }
+    hasTimecode_ = true;
+    lastTimecode_ = timecode;
+  }
+  stats.frames++;
+  windowFrames_++;
+  return true;
+}
+
+bool DDPReceiver::acceptSequence(uint8_t sequence, unsigned long now)
+{
+  bool resync = now - lastPacketMs_ > DDP_SEQUENCE_RESET_MS;
+  lastPacketMs_ = now;
+
+  // 0 means the sender does not number its packets
+  if (sequence == 0)
+  {
+    return true;
+  }
+  if (lastSequence_ != 0 && !resync)
+  {
+    // numbers run 1 to 15 and wrap to 1
+    uint8_t ahead = (sequence - lastSequence_ + 15) % 15;
+    if (ahead == 0 || ahead > 15 - DDP_SEQUENCE_WINDOW)
+    {
+      return false;
+    }
+  }
+  lastSequence_ = sequence;
+  return true;
+}
+
+void DDPReceiver::countRates(unsigned long now)
+{
+  if (now - windowStartMs_ >= 1000)
+  {
+    stats.packetsPerSecond = windowPackets_ * 1000 / (now - windowStartMs_);
+    stats.framesPerSecond = windowFrames_ * 1000 / (now - windowStartMs_);
+    windowPackets_ = windowFrames_ = 0;
+    windowStartMs_ = now;
+  }
+}
+
+IngestFormat DDPReceiver::getFormat() const
+{
+  return bytesPerPixel_ == 3 ? INGEST_RGB8 : INGEST_GRAY8;
+}
+
+const uint8_t *DDPReceiver::getChannels() const
+{
+  return channels_;
+}
+
+size_t DDPReceiver::getFrameSize() const
+{
+  return ROWS * COLS * bytesPerPixel_;
+}
@@ -0,0 +1,90 @@
+#include "dmxframe.h"
+
+void DmxFrame::configure(uint8_t channelsPerPixel)
+{
+  channelsPerPixel_ = constrain(channelsPerPixel, 1, 3);
+  pixelsPerUniverse_ = DMX_SLOTS / channelsPerPixel_;
+  universes_ = (ROWS * COLS + pixelsPerUniverse_ - 1) / pixelsPerUniverse_;
+  received_ = 0;
+  hasComplete_ = false;
+  frames = stale = 0;
+  memset(pixels_, 0, sizeof(pixels_));
+}
+
+uint8_t DmxFrame::getChannelsPerPixel() const
+{
+  return channelsPerPixel_;
+}
+
+uint8_t DmxFrame::getUniverses() const
+{
+  return universes_;
+}
+
+IngestFormat DmxFrame::getFormat() const
+{
+  return channelsPerPixel_ == 3 ? INGEST_RGB8 : INGEST_GRAY8;
+}
+
+void DmxFrame::write(uint8_t index, const uint8_t *slots, uint16_t length, bool synchronous)
+{
+  if (index >= universes_)
+  {
+    return;
+  }
+
+  int first = index * pixelsPerUniverse_;
+  int count = min((int)pixelsPerUniverse_, ROWS * COLS - first);
+  count = min(count, length / channelsPerPixel_);
+
+  if (channelsPerPixel_ == 2)
+  {
+    // the fine slot is below what the panel shows
+    for (int i = 0; i < count; i++)
+    {
+      pixels_[first + i] = slots[i * 2];
+    }
+  }
+  else
+  {
+    memcpy(pixels_ + first * channelsPerPixel_, slots, count * channelsPerPixel_);
+  }
+
+  if (!synchronous && (received_ & (1 << index)))
+  {
+    complete();
+  }
+  received_ |= 1 << index;
+  if (!synchronous && received_ == (1 << universes_) - 1)
+  {
+    complete();
+  }
+}
+
+void DmxFrame::complete()
+{
+  if (!received_)
+  {
+    return;
+  }
+  if (hasComplete_)
+  {
+    stale++;
+  }
+  memcpy(complete_, pixels_, channelsPerPixel_ == 3 ? ROWS * COLS * 3 : ROWS * COLS);
+  hasComplete_ = true;
+  completeUs_ = micros();
+  received_ = 0;
+}
+
+const uint8_t *DmxFrame::take(uint32_t &completeUs)
+{
+  if (!hasComplete_)
+  {
+    return nullptr;
+  }
+  hasComplete_ = false;
+  frames++;
+  completeUs = completeUs_;
+  return complete_;
+}
@@ -0,0 +1,193 @@
+#include "effects.h"
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "the effect kernels expect pixel x of a word in byte x"
+#endif
+static_assert(COLS % 4 == 0, "rows are processed as whole words");
+
+#define WORDS (ROWS * COLS / 4)
+#define ROW_WORDS (COLS / 4)
+
+// Every kernel splits a word into its even and odd bytes, each widened to a
+// 16 bit lane. Sums and differences then fit into a lane and bit 8 of each
+// lane tells about overflow or borrow without touching the neighbour.
+#define LANES 0x00FF00FFu
+#define CARRY 0x01000100u
+
+namespace
+{
+  inline uint32_t load(const uint8_t *buffer, int word)
+  {
+    uint32_t value;
+    memcpy(&value, buffer + word * 4, 4);
+    return value;
+  }
+
+  inline void store(uint8_t *buffer, int word, uint32_t value)
+  {
+    memcpy(buffer + word * 4, &value, 4);
+  }
+
+  inline uint32_t repeat(uint8_t value)
+  {
+    return value * 0x01010101u;
+  }
+
+  // 0xFF in every byte that is greater than level
+  inline uint32_t greaterMask(uint32_t word, uint8_t level)
+  {
+    uint32_t bias = (0xFF - level) * 0x00010001u;
+    uint32_t even = (((word & LANES) + bias) >> 8) & 0x00010001u;
+    uint32_t odd = ((((word >> 8) & LANES) + bias) >> 8) & 0x00010001u;
+    return (even | odd << 8) * 0xFF;
+  }
+}
+
+namespace Effects
+{
+  void scale(uint8_t *buffer, uint16_t factor)
+  {
+    if (factor >= 256)
+    {
+      return;
+    }
+    for (int i = 0; i < WORDS; i++)
+    {
+      uint32_t word = load(buffer, i);
+      uint32_t even = ((word & LANES) * factor >> 8) & LANES;
+      uint32_t odd = (((word >> 8) & LANES) * factor) & ~LANES;
+      store(buffer, i, even | odd);
+    }
+  }
+
+  void decay(uint8_t *buffer, uint8_t amount)
+  {
+    uint32_t subtrahend = amount * 0x00010001u;
+    for (int i = 0; i < WORDS; i++)
+    {
+      uint32_t word = load(buffer, i);
+      uint32_t even = ((word & LANES) | CARRY) - subtrahend;
+      uint32_t odd = (((word >> 8) & LANES) | CARRY) - subtrahend;
+      // a lane that had to borrow its carry bit went below zero
+      even &= ((even & CARRY) >> 8) * 0xFF;
+      odd &= ((odd & CARRY) >> 8) * 0xFF;
+      store(buffer, i, even | odd << 8);
+    }
+  }
+
+  void addSaturate(uint8_t *buffer, const uint8_t *source)
+  {
+    for (int i = 0; i < WORDS; i++)
+    {
+      uint32_t word = load(buffer, i);
+      uint32_t other = load(source, i);
+      uint32_t even = (word & LANES) + (other & LANES);
+      uint32_t odd = ((word >> 8) & LANES) + ((other >> 8) & LANES);
+      even = (even | ((even & CARRY) >> 8) * 0xFF) & LANES;
+      odd = (odd | ((odd & CARRY) >> 8) * 0xFF) & LANES;
+      store(buffer, i, even | odd << 8);
+    }
+  }
+
+  void threshold(uint8_t *buffer, uint8_t level, uint8_t on)
+  {
+    uint32_t value = repeat(on);
+    for (int i = 0; i < WORDS; i++)
+    {
+      store(buffer, i, greaterMask(load(buffer, i), level) & value);
+    }
+  }
+
+  // A mask per threshold and word costs more than the pixels themselves, so
+  // the steps go into a table once and every pixel is looked up in it.
+  void quantize(uint8_t *buffer, const uint8_t *thresholds, const uint8_t *values, int count)
+  {
+    uint8_t table[256];
+    int from = 0;
+    uint8_t value = 0;
+    for (int step = 0; step < count; step++)
+    {
+      // up to and including a threshold keeps the value of the step below
+      int to = thresholds[step] + 1;
+      memset(table + from, value, to - from);
+      from = to;
+      value = values[step];
+    }
+    memset(table + from, value, 256 - from);
+
+    for (int i = 0; i < ROWS * COLS; i++)
+    {
+      buffer[i] = table[buffer[i]];
+    }
+  }
+
+  void shift(uint8_t *buffer, Direction direction, bool wrap, uint8_t fill)
+  {
+    switch (direction)
+    {
+    case LEFT:
+      for (int row = 0; row < WORDS; row += ROW_WORDS)
+      {
+        uint32_t first = load(buffer, row);
+        uint32_t incoming = wrap ? first & 0xFF : fill;
+        uint32_t word = first;
+        for (int i = row; i < row + ROW_WORDS - 1; i++)
+        {
+          uint32_t next = load(buffer, i + 1);
+          store(buffer, i, word >> 8 | next << 24);
+          word = next;
+        }
+        store(buffer, row + ROW_WORDS - 1, word >> 8 | incoming << 24);
+      }
+      break;
+
+    case RIGHT:
+      for (int row = 0; row < WORDS; row += ROW_WORDS)
+      {
+        uint32_t last = load(buffer, row + ROW_WORDS - 1);
+        uint32_t incoming = wrap ? last >> 24 : fill;
+        uint32_t word = last;
+        for (int i = row + ROW_WORDS - 1; i > row; i--)
+        {
+          uint32_t previous = load(buffer, i - 1);
+          store(buffer, i, word << 8 | previous >> 24);
+          word = previous;
+        }
+        store(buffer, row, word << 8 | incoming);
+      }
+      break;
+
+    case UP:
+    {
+      uint8_t first[COLS];
+      memcpy(first, buffer, COLS);
+      memmove(buffer, buffer + COLS, (ROWS - 1) * COLS);
+      if (wrap)
+      {
+        memcpy(buffer + (ROWS - 1) * COLS, first, COLS);
+      }
+      else
+      {
+        memset(buffer + (ROWS - 1) * COLS, fill, COLS);
+      }
+      break;
+    }
+
+    case DOWN:
+    {
+      uint8_t last[COLS];
+      memcpy(last, buffer + (ROWS - 1) * COLS, COLS);
+      memmove(buffer + COLS, buffer, (ROWS - 1) * COLS);
+      if (wrap)
+      {
+        memcpy(buffer, last, COLS);
+      }
+      else
+      {
+        memset(buffer, fill, COLS);
+      }
+      break;
+    }
+    }
+  }
+}
@@ -0,0 +1,141 @@
+#include "ingest.h"
+#include "commands.h"
+#include "screen.h"
+
+using namespace IngestKernels;
+
+Ingest_ &Ingest_::getInstance()
+{
+  static Ingest_ instance;
+  return instance;
+}
+
+Ingest_::Ingest_()
+{
+  memset(buffers_, 0, sizeof(buffers_));
+  build(tables_[0], IngestSettings());
+}
+
+void Ingest_::build(Tables &tables, const IngestSettings &settings)
+{
+  tables.settings = settings;
+  tables.identity = buildLut(tables.lut, settings.gamma, settings.blackLevel);
+  tables.weights = lumaWeights(settings.luma);
+  tables.version = nextVersion_++;
+}
+
+bool Ingest_::submit(IngestFormat format, const uint8_t *data, size_t length, uint32_t receivedUs)
+{
+  // two streams at once, e.g. websocket frames while DDP runs
+  if (busy_.exchange(true, std::memory_order_acquire))
+  {
+    stats.collisions++;
+    return false;
+  }
+
+  uint32_t start = micros();
+  stats.frames++;
+  receivedUs_[back_] = receivedUs ? receivedUs : start;
+  const Tables &tables = tables_[activeTables_.load(std::memory_order_acquire)];
+
+  size_t size = frameSize(format);
+  if (length < size)
+  {
+    memcpy(scratch_, data, length);
+    memset(scratch_ + length, 0, size - length);
+    data = scratch_;
+  }
+
+  uint8_t *frame = buffers_[back_];
+  switch (format)
+  {
+  case INGEST_RGB8:
+    rgbToLuma(frame, data, tables.weights);
+    break;
+  case INGEST_GRAY8:
+    memcpy(frame, data, ROWS * COLS);
+    break;
+  case INGEST_GRAY4:
+    gray4ToGray8(frame, data);
+    break;
+  case INGEST_MONO1:
+    // the table is applied to the single on value right here
+    mono1ToGray8(frame, data, tables.lut[255]);
+    break;
+  }
+  if (!tables.identity && format != INGEST_MONO1)
+  {
+    applyLut(frame, tables.lut);
+  }
+
+  uint32_t hash = hashFrame(frame);
+  bool duplicate = hashVersion_ == tables.version && hash == lastHash_;
+  lastHash_ = hash;
+  hashVersion_ = tables.version;
+
+  if (duplicate)
+  {
+    stats.duplicates++;
+  }
+  else
+  {
+    // latest wins, a frame the drawing task did not take yet is dropped
+    uint8_t previous = ready_.exchange(back_ | FRESH);
+    if (previous & FRESH)
+    {
+      stats.stale++;
+    }
+    back_ = previous & ~FRESH;
+    Commands.wake();
+  }
+
+  uint32_t took = micros() - start;
+  stats.maxConvertUs = max(stats.maxConvertUs, took);
+  stats.avgConvertUs = stats.avgConvertUs - stats.avgConvertUs / 8 + took / 8;
+  busy_.store(false, std::memory_order_release);
+  return !duplicate;
+}
+
+void Ingest_::apply()
+{
+  if (!(ready_.load() & FRESH))
+  {
+    return;
+  }
+  front_ = ready_.exchange(front_) & ~FRESH;
+  Screen.setLayer(LAYER_STREAM, buffers_[front_]);
+  stats.shown++;
+
+  uint32_t age = micros() - receivedUs_[front_];
+  stats.lastAgeUs = age;
+  stats.maxAgeUs = max(stats.maxAgeUs, age);
+  stats.avgAgeUs = stats.avgAgeUs - stats.avgAgeUs / 8 + age / 8;
+}
+
+void Ingest_::reset()
+{
+  // a network task may be converting a frame of the stopped source, delay()
+  // lets it finish even on a single core
+  while (busy_.exchange(true, std::memory_order_acquire))
+  {
+    delay(1);
+  }
+  ready_.fetch_and((uint8_t)~FRESH);
+  hashVersion_ = 0;
+  stats = IngestStats();
+  busy_.store(false, std::memory_order_release);
+}
+
+void Ingest_::configure(const IngestSettings &settings)
+{
+  uint8_t spare = activeTables_.load(std::memory_order_relaxed) ^ 1;
+  build(tables_[spare], settings);
+  activeTables_.store(spare, std::memory_order_release);
+}
+
+IngestSettings Ingest_::getSettings() const
+{
+  return tables_[activeTables_.load(std::memory_order_acquire)].settings;
+}
+
+Ingest_ &Ingest = Ingest.getInstance();
@@ -0,0 +1,130 @@
+#include "ingestkernels.h"
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "the ingest kernels expect pixel x of a word in byte x"
+#endif
+static_assert(ROWS * COLS % 8 == 0, "frames are converted in whole words");
+
+#define PIXELS (ROWS * COLS)
+#define WORDS (PIXELS / 4)
+
+namespace
+{
+  const uint8_t LUMA[][3] = {
+      {85, 86, 85},
+      {77, 150, 29},
+      {54, 183, 19},
+  };
+
+  // a nibble of a 1 bpp row as four bytes, its MSB is the leftmost pixel
+  const uint32_t NIBBLE_MASK[16] = {
+      0x00000000, 0xFF000000, 0x00FF0000, 0xFFFF0000,
+      0x0000FF00, 0xFF00FF00, 0x00FFFF00, 0xFFFFFF00,
+      0x000000FF, 0xFF0000FF, 0x00FF00FF, 0xFFFF00FF,
+      0x0000FFFF, 0xFF00FFFF, 0x00FFFFFF, 0xFFFFFFFF,
+  };
+
+  inline uint32_t load(const uint8_t *buffer, int word)
+  {
+    uint32_t value;
+    memcpy(&value, buffer + word * 4, 4);
+    return value;
+  }
+
+  inline void store(uint8_t *buffer, int word, uint32_t value)
+  {
+    memcpy(buffer + word * 4, &value, 4);
+  }
+}
+
+namespace IngestKernels
+{
+  size_t frameSize(IngestFormat format)
+  {
+    switch (format)
+    {
+    case INGEST_RGB8:
+      return PIXELS * 3;
+    case INGEST_GRAY4:
+      return PIXELS / 2;
+    case INGEST_MONO1:
+      return PIXELS / 8;
+    default:
+      return PIXELS;
+    }
+  }
+
+  const uint8_t *lumaWeights(LumaWeights luma)
+  {
+    return LUMA[luma];
+  }
+
+  bool buildLut(uint8_t *lut, float gamma, uint8_t blackLevel)
+  {
+    for (int i = 0; i < 256; i++)
+    {
+      if (i <= blackLevel && i > 0)
+      {
+        lut[i] = 0;
+      }
+      else
+      {
+        lut[i] = gamma == 1.0f ? i : (uint8_t)(powf(i / 255.0f, gamma) * 255.0f + 0.5f);
+      }
+    }
+    return gamma == 1.0f && blackLevel == 0;
+  }
+
+  // per pixel, packing red, green and blue of two pixels into the lanes of
+  // one word measured no faster than this
+  void rgbToLuma(uint8_t *target, const uint8_t *source, const uint8_t *weights)
+  {
+    for (int i = 0; i < PIXELS; i++, source += 3)
+    {
+      target[i] = (source[0] * weights[0] + source[1] * weights[1] + source[2] * weights[2]) >> 8;
+    }
+  }
+
+  // two bytes are four pixels
+  void gray4ToGray8(uint8_t *target, const uint8_t *source)
+  {
+    for (int i = 0; i < WORDS; i++)
+    {
+      uint32_t pair = source[i * 2] | source[i * 2 + 1] << 8;
+      uint32_t high = (pair >> 4) & 0x0F0F;
+      uint32_t low = pair & 0x0F0F;
+      uint32_t word = (high & 0xFF) | (high & 0xFF00) << 8;
+      word |= ((low & 0xFF) | (low & 0xFF00) << 8) << 8;
+      store(target, i, word | word << 4);
+    }
+  }
+
+  // every byte is eight pixels in two words
+  void mono1ToGray8(uint8_t *target, const uint8_t *source, uint8_t on)
+  {
+    uint32_t value = on * 0x01010101u;
+    for (int i = 0; i < PIXELS / 8; i++)
+    {
+      store(target, i * 2, NIBBLE_MASK[source[i] >> 4] & value);
+      store(target, i * 2 + 1, NIBBLE_MASK[source[i] & 0x0F] & value);
+    }
+  }
+
+  void applyLut(uint8_t *frame, const uint8_t *lut)
+  {
+    for (int i = 0; i < PIXELS; i++)
+    {
+      frame[i] = lut[frame[i]];
+    }
+  }
+
+  uint32_t hashFrame(const uint8_t *frame)
+  {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < WORDS; i++)
+    {
+      hash = (hash ^ load(frame, i)) * 16777619u;
+    }
+    return hash;
+  }
+}
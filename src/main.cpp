@@ -14,6 +14,7 @@
 #ifdef ESP32
 #include <WiFi.h>
 #include <ESPmDNS.h>
+#include <esp_timer.h>
 #endif
 #ifdef ESP32
 #include <Preferences.h>
@@ -39,6 +40,9 @@
 #include "plugins/StarsPlugin.h"
 #include "plugins/TickingClockPlugin.h"
 #include "plugins/ArtNet.h"
+#ifdef ESP32
+#include "plugins/SACNPlugin.h"
+#endif
 #include "plugins/TetrisDemoPlugin.h"
 #include "plugins/ArcadeSpritesPlugin.h"
 #include "plugins/MoonPhasePlugin.h"
@@ -57,10 +61,13 @@
 #endif
 
 #include "asyncwebserver.h"
+#include "commands.h"
+#include "ingest.h"
 #include "messages.h"
 #include "ota.h"
 #include "screen.h"
 #include "secrets.h"
+#include "tasks.h"
 #include "websocket.h"
 
 BfButton btn(BfButton::STANDALONE_DIGITAL, PIN_BUTTON, true, LOW);
@@ -162,7 +169,7 @@ void pressHandler(BfButton *btn, BfButton::press_pattern_t pattern)
     if (currentStatus != LOADING)
     {
       Scheduler.clearSchedule();
-      pluginManager.activateNextPlugin();
+      Commands.post(CMD_NEXT_PLUGIN);
     }
     break;
 
@@ -192,7 +199,7 @@ void pressHandler(BfButton *btn, BfButton::press_pattern_t pattern)
   case BfButton::LONG_PRESS:
     if (currentStatus != LOADING)
     {
-      pluginManager.activatePersistedPlugin();
+      Commands.post(CMD_PERSISTED_PLUGIN);
     }
     break;
   }
@@ -247,6 +254,9 @@ void baseSetup()
   pluginManager.addPlugin(new AnimationPlugin());
   pluginManager.addPlugin(new DDPPlugin());
   pluginManager.addPlugin(new ArtNetPlugin());
+#ifdef ESP32
+  pluginManager.addPlugin(new SACNPlugin());
+#endif
 #endif
 
   pluginManager.init();
@@ -267,36 +277,125 @@ static unsigned long lastWeatherTick = 0;
 #include "WeatherService.h"
 
 
+// network and housekeeping work that may block for seconds
+void serviceWork()
+{
+  static uint8_t taskCounter = 0;
+  static unsigned long lastHeartbeat = 0;
+
+  // Background stock fetch
+  if (currentStatus == NONE && (taskCounter % 64) == 0) { // ~1/16th der Weather-Frequenz
+    StockService::getInstance().maybeFetch();
+  }
+
+  // Background weather fetch (independent of active plugin)
+  if ((taskCounter % 8) == 0)
+  {
+    WeatherService::getInstance().maybeFetch();
+  }
+
+  if ((taskCounter % 16) == 0)
+  {
+    if (WiFi.status() != WL_CONNECTED)
+    {
+      connectToWiFi();
+    }
+  }
+
+  // Heartbeat: alle 5s Status ins Log
+  if (millis() - lastHeartbeat >= 5000)
+  {
+    wl_status_t st = WiFi.status();
+    IPAddress ip = WiFi.localIP();
+    IPAddress gw = WiFi.gatewayIP();
+    long rssi = WiFi.RSSI();
+    uint32_t freeH = ESP.getFreeHeap();
+    uint32_t minH  = ESP.getMinFreeHeap();
+    uint32_t maxBlk= ESP.getMaxAllocHeap();
+    Serial.printf("[HB] up=%lus status=%d ip=%s gw=%s rssi=%lddBm heap(free=%lu,min=%lu,maxBlk=%lu)\n",
+                  millis() / 1000,
+                  (int)st,
+                  ip.toString().c_str(),
+                  gw.toString().c_str(),
+                  rssi,
+                  (unsigned long)freeH,
+                  (unsigned long)minH,
+                  (unsigned long)maxBlk);
+    lastHeartbeat = millis();
+  }
+
+  taskCounter++;
+  if (taskCounter > 16)
+  {
+    taskCounter = 0;
+  }
+}
+
 #ifdef ESP32
-TaskHandle_t screenDrawingTaskHandle = NULL;
+TaskLoad renderLoad;
+TaskLoad serviceLoad;
+TaskLoad controlLoad;
 
-void screenDrawingTask(void *parameter)
+void renderTask(void *parameter)
 {
   Screen.setup();
+  Commands.setConsumer(xTaskGetCurrentTaskHandle());
+  for (;;)
+  {
+    renderLoad.wake();
+    Commands.apply();
+    Screen.updateRefreshProfile();
+    uint32_t waitUs = pluginManager.runActivePlugin();
+    Ingest.apply();
+    waitUs = min(waitUs, Messages.update());
+    renderLoad.sleep();
+    // sleep until the next frame or message step is due, at least one tick,
+    // a posted command wakes up early
+    ulTaskNotifyTake(pdTRUE, max((TickType_t)1, (TickType_t)pdMS_TO_TICKS(waitUs / 1000)));
+  }
+}
+
+void serviceTask(void *parameter)
+{
   for (;;)
   {
-    pluginManager.runActivePlugin();
-    vTaskDelay(10);
+    serviceLoad.wake();
+    serviceWork();
+    serviceLoad.sleep();
+    vTaskDelay(pdMS_TO_TICKS(10));
   }
 }
 
 void setup()
 {
   baseSetup();
-  xTaskCreatePinnedToCore(screenDrawingTask,
-                          "screenDrawingTask",
-                          10000,
-                          NULL,
-                          1,
-                          &screenDrawingTaskHandle,
-                          0);
+  Tasks.spawn(renderTask, "render", RENDER_STACK, RENDER_PRIORITY, RENDER_CORE, &renderLoad);
+  Tasks.spawn(serviceTask, "service", SERVICE_STACK, SERVICE_PRIORITY, SERVICE_CORE, &serviceLoad);
+  // setup() runs in the control loop task
+  Tasks.add("loopTask", ARDUINO_RUNNING_CORE, xTaskGetCurrentTaskHandle(), &controlLoad);
+  Tasks.add("async_tcp", CONFIG_ASYNC_TCP_RUNNING_CORE);
+  Tasks.add("async_udp", CONFIG_ARDUINO_UDP_RUNNING_CORE);
+
+  // a plugin spinning in the render task starves every task below it on
+  // that core, so the watchdog runs from the high priority timer task
+  esp_timer_create_args_t watchdogArgs = {};
+  watchdogArgs.callback = [](void *)
+  { pluginManager.checkWatchdog(); };
+  watchdogArgs.name = "pluginWatchdog";
+  esp_timer_handle_t watchdog;
+  esp_timer_create(&watchdogArgs, &watchdog);
+  esp_timer_start_periodic(watchdog, 1000000);
 }
 #endif
 #ifdef ESP8266
 void screenDrawingTask()
 {
   Screen.setup();
+  Commands.apply();
+  Screen.updateRefreshProfile();
   pluginManager.runActivePlugin();
+  Ingest.apply();
+  Messages.update();
   yield();
 }
 
@@ -310,7 +409,10 @@ void setup()
 void loop()
 {
   static uint8_t taskCounter = 0;
-  static unsigned long lastHeartbeat = 0;
+
+#ifdef ESP32
+  controlLoad.wake();
+#endif
 
   btn.read();
 
@@ -319,7 +421,11 @@ void loop()
 #endif
 
 #if !defined(ESP32) && !defined(ESP8266)
+  Commands.apply();
+  Screen.updateRefreshProfile();
   pluginManager.runActivePlugin();
+  Ingest.apply();
+  Messages.update();
 #endif
 
   if (currentStatus == NONE)
@@ -330,48 +436,11 @@ void loop()
     {
       Messages.scrollMessageEveryMinute();
     }
-
-    // Background stock fetch
-    if ((taskCounter % 64) == 0) { // ~1/16th der Weather-Frequenz
-      StockService::getInstance().maybeFetch();
-    }
-  }
-
-  // Background weather fetch (independent of active plugin)
-  if ((taskCounter % 8) == 0)
-  {
-    WeatherService::getInstance().maybeFetch();
-  }
-
-  if ((taskCounter % 16) == 0)
-  {
-    if (WiFi.status() != WL_CONNECTED)
-    {
-      connectToWiFi();
-    }
   }
 
-  // Heartbeat: alle 5s Status ins Log
-  if (millis() - lastHeartbeat >= 5000)
-  {
-    wl_status_t st = WiFi.status();
-    IPAddress ip = WiFi.localIP();
-    IPAddress gw = WiFi.gatewayIP();
-    long rssi = WiFi.RSSI();
-    uint32_t freeH = ESP.getFreeHeap();
-    uint32_t minH  = ESP.getMinFreeHeap();
-    uint32_t maxBlk= ESP.getMaxAllocHeap();
-    Serial.printf("[HB] up=%lus status=%d ip=%s gw=%s rssi=%lddBm heap(free=%lu,min=%lu,maxBlk=%lu)\n",
-                  millis() / 1000,
-                  (int)st,
-                  ip.toString().c_str(),
-                  gw.toString().c_str(),
-                  rssi,
-                  (unsigned long)freeH,
-                  (unsigned long)minH,
-                  (unsigned long)maxBlk);
-    lastHeartbeat = millis();
-  }
+#ifndef ESP32
+  serviceWork();
+#endif
 
   taskCounter++;
   if (taskCounter > 16)
@@ -382,5 +451,9 @@ void loop()
 #ifdef ENABLE_SERVER
   cleanUpClients();
 #endif
+
+#ifdef ESP32
+  controlLoad.sleep();
+#endif
   delay(1);
 }
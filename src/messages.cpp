@@ -1,4 +1,5 @@
 #include "messages.h"
+#include "commands.h"
 #include <SPI.h>
 
 Messages_ &Messages_::getInstance()
@@ -8,7 +9,7 @@ Messages_ &Messages_::getInstance()
 }
 
 void Messages_::add(std::string text, int repeat, int id, int delay,
-                    std::vector<int> graph, int miny, int maxy)
+                    std::vector<int> graph, int miny, int maxy, bool urgent)
 {
   // First remove any existing message with same id
   remove(id);
@@ -25,8 +26,17 @@ void Messages_::add(std::string text, int repeat, int id, int delay,
     msg->miny = miny;
     msg->maxy = maxy;
 
-    activeMessages.push_back(msg);
-    previousMinute = -1; // Force immediate display
+    if (urgent)
+    {
+      // goes first, whatever was playing starts over after it
+      activeMessages.insert(activeMessages.begin(), msg);
+      playing = false;
+    }
+    else
+    {
+      activeMessages.push_back(msg);
+    }
+    scroll(); // Force immediate display
   }
   else
   {
@@ -43,44 +53,183 @@ void Messages_::remove(int id)
 
   if (it != activeMessages.end())
   {
+    size_t index = it - activeMessages.begin();
     messagePool.release(*it);
     activeMessages.erase(it);
+
+    // keep playing the same message, or the one after a removed one
+    if (index < playIndex)
+    {
+      playIndex--;
+    }
+    else if (index == playIndex)
+    {
+      rewind();
+    }
   }
 }
 
 void Messages_::scroll()
 {
-  Screen.persist();
+  if (!playing && !activeMessages.empty())
+  {
+    playing = true;
+    playIndex = 0;
+    rewind();
+    lastStep = millis() - activeMessages.front()->delay;
+  }
+}
+
+void Messages_::rewind()
+{
+  playingGraph = false;
+  scrollPosition = -COLS;
+}
+
+void Messages_::next()
+{
+  Message *msg = activeMessages[playIndex];
+  if (msg->repeat != -1 && --(msg->repeat) < 0)
+  {
+    messagePool.release(msg);
+    activeMessages.erase(activeMessages.begin() + playIndex);
+  }
+  else
+  {
+    playIndex++;
+  }
+  rewind();
+}
+
+uint32_t Messages_::blinkIndicator()
+{
+  if (currentStatus != NONE)
+  {
+    // updates and uploads use the system layer themselves
+    return UINT32_MAX;
+  }
+
+  // blinks on top of whatever the plugin draws at (0, 0)
+  if (activeMessages.empty())
+  {
+    if (indicatorPixel >= 0)
+    {
+      indicatorPixel = -1;
+      Screen.hideLayer(LAYER_SYSTEM);
+    }
+    return UINT32_MAX;
+  }
+
+  unsigned long now = millis();
+  int pixel = (now / 1000) & 0b00000001;
+  if (pixel != indicatorPixel)
+  {
+    indicatorPixel = pixel;
+    indicator.setPixel(0, 0, indicatorPixel * 255);
+    Screen.setLayer(LAYER_SYSTEM, indicator, BLEND_MAX);
+  }
+  return (1000 - now % 1000) * 1000;
+}
+
+uint32_t Messages_::update()
+{
+  uint32_t blinkUs = blinkIndicator();
+  return min(blinkUs, step());
+}
+
+uint32_t Messages_::step()
+{
+  if (!playing)
+  {
+    return UINT32_MAX;
+  }
 
-  for (auto it = activeMessages.begin(); it != activeMessages.end();)
+  if (currentStatus != NONE)
   {
-    Message *msg = *it;
+    // updates and uploads own the screen, the next minute starts over
+    playing = false;
+    Screen.hideLayer(LAYER_OVERLAY);
+    return UINT32_MAX;
+  }
 
-    // Print text and graph for the message
-    if (msg->text.length() > 0)
-      Screen.scrollText(msg->text.c_str(), msg->delay);
-    if (msg->graph.size() > 0)
-      Screen.scrollGraph(msg->graph, msg->miny, msg->maxy, msg->delay);
+  if (playIndex >= activeMessages.size())
+  {
+    // everything shown, back to the plugin frame
+    playing = false;
+    Screen.hideLayer(LAYER_OVERLAY);
+    return UINT32_MAX;
+  }
 
-    if (msg->repeat != -1)
+  Message *msg = activeMessages[playIndex];
+  unsigned long now = millis();
+  if (now - lastStep < (unsigned long)msg->delay)
+  {
+    return (msg->delay - (now - lastStep)) * 1000;
+  }
+  lastStep = now;
+  // next() may hand msg back to the pool
+  uint32_t delayUs = msg->delay * 1000;
+
+  if (!playingGraph && msg->text.length() > 0)
+  {
+    // rendered on the first step, repeats reuse the strip
+    if (scrollPosition == -COLS)
     {
-      if (--(msg->repeat) < 0)
+      msg->strip.render(msg->text);
+    }
+    overlay.clear();
+    msg->strip.drawWindow(overlay.pixels, scrollPosition, 4);
+    Screen.setLayer(LAYER_OVERLAY, overlay);
+
+    if (++scrollPosition >= msg->strip.width())
+    {
+      playingGraph = true;
+      scrollPosition = -COLS;
+    }
+  }
+  else if (msg->graph.size() > 0)
+  {
+    playingGraph = true;
+    drawGraph(msg);
+    Screen.setLayer(LAYER_OVERLAY, overlay);
+
+    if (++scrollPosition >= (int)msg->graph.size())
+    {
+      next();
+    }
+  }
+  else
+  {
+    next();
+  }
+
+  return delayUs;
+}
+
+void Messages_::drawGraph(const Message *msg)
+{
+  overlay.clear();
+
+  int y1 = -999;
+  for (int x = 0; x < COLS; x++)
+  {
+    int index = scrollPosition + x;
+    if (index >= 0 && index < (int)msg->graph.size())
+    {
+      int y2 = ROWS - ((msg->graph[index] - msg->miny + 1) * ROWS) / (msg->maxy - msg->miny + 1);
+      // if we are not first pixel on screen
+      // and the distance is < 6, so we do not bridge too big gaps
+      if (x > 0 && index > 0 && abs(y2 - y1) < 6)
       {
-        messagePool.release(msg);
-        it = activeMessages.erase(it);
+        overlay.drawLine(x - 1, y1, x, y2, 255);
       }
       else
       {
-        ++it;
+        overlay.setPixel(x, y2, 255);
       }
-    }
-    else
-    {
-      ++it;
+      y1 = y2; // this value is next values previous value
     }
   }
-
-  Screen.loadFromStorage();
 }
 
 void Messages_::scrollMessageEveryMinute()
@@ -91,24 +240,10 @@ void Messages_::scrollMessageEveryMinute()
   {
     if (timeinfo.tm_min != previousMinute)
     {
-      scroll();
+      // started by the drawing task, which owns the messages
+      Commands.post(CMD_SCROLL_MESSAGES);
       previousMinute = timeinfo.tm_min;
     }
-
-    if (timeinfo.tm_sec != previousSecond)
-    {
-      if (!activeMessages.empty())
-      {
-        indicatorPixel = timeinfo.tm_sec & 0b00000001;
-        Screen.setPixel(0, 0, indicatorPixel);
-      }
-      else if (indicatorPixel > 0)
-      {
-        indicatorPixel = 0;
-        Screen.setPixel(0, 0, indicatorPixel);
-      }
-      previousSecond = timeinfo.tm_sec;
-    }
   }
 }
 
@@ -13,12 +13,9 @@ void onOTAStart()
     Serial.println("OTA update started!");
     currentStatus = UPDATE;
 
-    std::vector<int> bits = Screen.readBytes(letterU);
-
-    for (int i = 0; i < bits.size(); i++)
-    {
-        Screen.setPixelAtIndex(i, bits[i]);
-    }
+    Canvas letter;
+    letter.blit(0, 0, letterU);
+    Screen.setLayer(LAYER_UPDATE, letter);
 }
 
 void onOTAProgress(size_t current, size_t final)
@@ -42,16 +39,14 @@ void onOTAEnd(bool success)
     {
         Serial.println("There was an error during OTA update!");
     }
-    std::vector<int> bits = Screen.readBytes(letterR);
-
-    for (int i = 0; i < bits.size(); i++)
-    {
-        Screen.setPixelAtIndex(i, bits[i]);
-    }
+    Canvas letter;
+    letter.blit(0, 0, letterR);
+    Screen.setLayer(LAYER_UPDATE, letter);
 
     delay(1000);
     currentStatus = NONE;
-    Screen.loadFromStorage();
+    // the plugin frame and the message indicator were kept underneath
+    Screen.hideLayer(LAYER_UPDATE);
 }
 
 void initOTA(AsyncWebServer &server)
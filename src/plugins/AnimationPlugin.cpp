@@ -28,7 +28,7 @@ void AnimationPlugin::setup()
         };
 
         auto makeFrame = [](const uint8_t rows8[8]){
-          std::vector<int> bytes(32, 0);
+          std::array<uint8_t, 32> bytes = {};
           for (int y = 0; y < 16; ++y)
           {
             uint8_t leftByte = 0;
@@ -53,8 +53,8 @@ void AnimationPlugin::setup()
                 }
               }
             }
-            bytes[y * 2 + 0] = (int)leftByte;
-            bytes[y * 2 + 1] = (int)rightByte;
+            bytes[y * 2 + 0] = leftByte;
+            bytes[y * 2 + 1] = rightByte;
           }
           return bytes;
         };
@@ -64,18 +64,13 @@ void AnimationPlugin::setup()
     }
 }
 
-void AnimationPlugin::loop()
+void AnimationPlugin::tick(uint32_t now, uint32_t dt)
 {
     int size = customAnimationFrames.size();
 
     if (size > 0)
     {
-        std::vector<int> bits = Screen.readBytes(customAnimationFrames[this->step]);
-
-        for (int i = 0; i < bits.size(); i++)
-        {
-            Screen.setPixelAtIndex(i, bits[i]);
-        }
+        Screen.drawGlyph(0, 0, Glyph{customAnimationFrames[this->step].data(), 16, 16});
 
         this->step++;
 
@@ -83,7 +78,6 @@ void AnimationPlugin::loop()
         {
             this->step = 0;
         }
-        delay(400);
     }
 }
 
@@ -99,22 +93,23 @@ void AnimationPlugin::websocketHook(DynamicJsonDocument &request)
         {
             for (int k = 0; k < 32; k++)
             {
-                if (k == 0)
-                {
-                    customAnimationFrames[i].resize(32);
-                }
-                customAnimationFrames[i][k] = (int)request["data"][i][k];
+                customAnimationFrames[i][k] = (uint8_t)request["data"][i][k];
             }
         }
     }
 }
 
-const std::vector<std::vector<int>> &AnimationPlugin::getFrames() const
+const std::vector<std::array<uint8_t, 32>> &AnimationPlugin::getFrames() const
 {
     return customAnimationFrames;
 }
 
 
+uint16_t AnimationPlugin::getFramePeriod() const
+{
+    return 400;
+}
+
 const char *AnimationPlugin::getName() const
 {
     return "Animation";
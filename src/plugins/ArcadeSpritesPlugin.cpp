@@ -99,8 +99,7 @@ void ArcadeSpritesPlugin::updateEntity(Entity& e, unsigned long now){
 }
 
 void ArcadeSpritesPlugin::render(){
-  Screen.beginUpdate();
-  Screen.clear();
+  Canvas canvas;
 
   const float AY = DISPLAY_ASPECT_YX; // pixel height / pixel width
   const bool doAC = (ARCADE_SPRITES_ASPECT_CORRECT != 0) && (AY != 1.0f);
@@ -121,13 +120,13 @@ void ArcadeSpritesPlugin::render(){
             py = (int)roundf(sy);
           }
 
-          if (px>=0 && px<16 && py>=0 && py<16) Screen.setPixel(px, py, 1, e.bright);
+          if (px>=0 && px<16 && py>=0 && py<16) canvas.setPixel(px, py, e.bright);
         }
       }
     }
   }
 
-  Screen.endUpdate();
+  Screen.present(canvas);
 }
 
 void ArcadeSpritesPlugin::setup(){
@@ -2,42 +2,111 @@
 
 void ArtNetPlugin::setup()
 {
+    stats = ArtNetStats();
+    synchronous = false;
+    configure(startUniverse, channelsPerPixel);
+
     artnet.begin();
-    artnet.setArtDmxCallback(onDmxFrame);
+    artnet.setArtDmxFunc([this](uint16_t universe, uint16_t length, uint8_t sequence, uint8_t *data)
+                         { onDmx(universe, length, data); });
     Serial.print("ArtNet server listening at IP: ");
     Serial.print(WiFi.localIP());
     Serial.print(" port: ");
     Serial.println(ART_NET_PORT);
-    artnet.setUniverse(1);
-    Serial.print("Universe: ");
-    Serial.println(artnet.getOutgoing());
+    Serial.printf("Universes: %u - %u, %u channels per pixel\n", startUniverse, startUniverse + frame.getUniverses() - 1, channelsPerPixel);
 }
 
-void ArtNetPlugin::teardown()
+void ArtNetPlugin::configure(uint16_t universe, uint8_t channels)
 {
+    startUniverse = universe & 0x7FFF;
+    frame.configure(channels);
+    channelsPerPixel = frame.getChannelsPerPixel();
 }
 
-void ArtNetPlugin::loop()
+void ArtNetPlugin::teardown()
 {
-    artnet.read();
+    artnet.stop();
+    Ingest.reset();
+    Screen.hideLayer(LAYER_STREAM);
 }
 
-const char *ArtNetPlugin::getName() const
+void ArtNetPlugin::loop()
 {
-    return "ArtNet";
+    // everything lwIP queued since the last call, only the newest complete
+    // frame is shown so a fast sender cannot build up latency
+    uint8_t drained = 0;
+    while (drained < ARTNET_DRAIN_MAX)
+    {
+        uint16_t opcode = artnet.read();
+        if (!artnet.getPacketSize())
+        {
+            break;
+        }
+        drained++;
+
+        switch (opcode)
+        {
+        case ART_SYNC:
+            // from now on DMX data waits for the next ArtSync
+            synchronous = true;
+            lastSyncMs = millis();
+            stats.syncs++;
+            frame.complete();
+            break;
+
+        case ART_POLL:
+            stats.polls++;
+            artnet.writePollReply(startUniverse, frame.getUniverses(), "OBEGRANSAD", "IKEA OBEGRANSAD LED wall");
+            break;
+        }
+    }
+    if (drained)
+    {
+        stats.queueDepth = drained;
+        stats.maxQueueDepth = max(stats.maxQueueDepth, drained);
+    }
+    uint32_t completeUs;
+    if (const uint8_t *pixels = frame.take(completeUs))
+    {
+        Ingest.submit(frame.getFormat(), pixels, IngestKernels::frameSize(frame.getFormat()), completeUs);
+    }
+
+    if (synchronous && millis() - lastSyncMs > ARTNET_SYNC_TIMEOUT_MS)
+    {
+        synchronous = false;
+    }
 }
 
-void ArtNetPlugin::onDmxFrame(uint16_t universe, uint16_t length, uint16_t outgoing, uint8_t *data)
+void ArtNetPlugin::onDmx(uint16_t universe, uint16_t length, const uint8_t *data)
 {
-    Serial.print("Universe: ");
-    Serial.println(universe);
-    if (universe == 0 || universe == outgoing)
+    if (universe < startUniverse || universe - startUniverse >= frame.getUniverses())
     {
-        for (int i = 0; i < ROWS * COLS; i++)
-        {
-            Screen.setPixelAtIndex(i, data[i] > 4, data[i]);
-        }
+        stats.ignored++;
+        return;
     }
+    stats.packets++;
+    frame.write(universe - startUniverse, data, length, synchronous);
+}
+
+void ArtNetPlugin::addStats(JsonObject object)
+{
+    object["startUniverse"] = startUniverse;
+    object["universes"] = frame.getUniverses();
+    object["channelsPerPixel"] = channelsPerPixel;
+    object["synchronous"] = synchronous;
+    object["packets"] = stats.packets;
+    object["ignored"] = stats.ignored;
+    object["frames"] = frame.frames;
+    object["syncs"] = stats.syncs;
+    object["polls"] = stats.polls;
+    object["stale"] = frame.stale;
+    object["queueDepth"] = stats.queueDepth;
+    object["maxQueueDepth"] = stats.maxQueueDepth;
+}
+
+const char *ArtNetPlugin::getName() const
+{
+    return "ArtNet";
 }
 
 void ArtNetPlugin::websocketHook(DynamicJsonDocument &request)
@@ -48,12 +117,10 @@ void ArtNetPlugin::websocketHook(DynamicJsonDocument &request)
     {
         if (!strcmp(event, "artnet"))
         {
-            uint16_t universe = request["universe"].as<uint16_t>();
-            Serial.print("Changing ArtNet Universe to ");
-            Serial.println(universe);
-            artnet.setUniverse(universe);
-            Serial.print("Current Universe: ");
-            Serial.println(artnet.getOutgoing());
+            uint16_t universe = request["universe"] | startUniverse;
+            uint8_t channels = request["channels"] | channelsPerPixel;
+            configure(universe, channels);
+            Serial.printf("ArtNet universes %u - %u, %u channels per pixel\n", startUniverse, startUniverse + frame.getUniverses() - 1, channelsPerPixel);
         }
     }
 }
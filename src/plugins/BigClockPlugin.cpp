@@ -20,23 +20,19 @@ void BigClockPlugin::loop()
   {
     if (previousHour != timeinfo.tm_hour || previousMinutes != timeinfo.tm_min)
     {
-      std::vector<int> hh = {(timeinfo.tm_hour - timeinfo.tm_hour % 10) / 10, timeinfo.tm_hour % 10};
-      std::vector<int> mm = {(timeinfo.tm_min - timeinfo.tm_min % 10) / 10, timeinfo.tm_min % 10};
-      bool leadingZero = (hh.at(0) == 0);
-      Screen.beginUpdate();
+      bool leadingZero = timeinfo.tm_hour < 10;
+      Screen.beginFrame();
       Screen.clear();
       if (leadingZero)
       {
-        hh.erase(hh.begin());
-        Screen.drawBigNumbers(COLS / 2, 0, hh);
-        Screen.drawBigNumbers(0, ROWS / 2, mm);
+        Screen.drawBigNumbers(COLS / 2, 0, {timeinfo.tm_hour});
       }
       else
       {
-        Screen.drawBigNumbers(0, 0, hh);
-        Screen.drawBigNumbers(0, ROWS / 2, mm);
+        Screen.drawBigNumbers(0, 0, {timeinfo.tm_hour / 10, timeinfo.tm_hour % 10});
       }
-      Screen.endUpdate();
+      Screen.drawBigNumbers(0, ROWS / 2, {timeinfo.tm_min / 10, timeinfo.tm_min % 10});
+      Screen.present();
     }
 
     previousMinutes = timeinfo.tm_min;
@@ -8,25 +8,29 @@ void BreakoutPlugin::initGame()
   this->ballDelay = this->BALL_DELAY_MAX;
   this->score = 0;
   this->level = 0;
-  newLevel();
+  this->gameState = this->GAME_STATE_LEVEL;
 }
 
 void BreakoutPlugin::initBricks()
 {
+  CO_BEGIN(building);
+
   this->destroyedBricks = 0;
-  for (byte i = 0; i < this->BRICK_AMOUNT; i++)
+  for (brick = 0; brick < this->BRICK_AMOUNT; brick++)
   {
-    this->bricks[i].x = i % this->X_MAX;
-    this->bricks[i].y = i / this->X_MAX;
-    Screen.setPixelAtIndex(this->bricks[i].y * this->X_MAX + this->bricks[i].x, this->LED_TYPE_ON, 50);
+    this->bricks[brick].x = brick % this->X_MAX;
+    this->bricks[brick].y = brick / this->X_MAX;
+    Screen.setPixelAtIndex(this->bricks[brick].y * this->X_MAX + this->bricks[brick].x, this->LED_TYPE_ON, 50);
 
-    delay(25);
+    CO_NEXT_FRAME(building);
   }
+
+  this->newLevel();
+  CO_END(building);
 }
 
 void BreakoutPlugin::newLevel()
 {
-  this->initBricks();
   for (byte i = 0; i < this->PADDLE_WIDTH; i++)
   {
     this->paddle[i].x = (this->X_MAX / 2) - (this->PADDLE_WIDTH / 2) + i;
@@ -189,19 +193,25 @@ void BreakoutPlugin::end()
 void BreakoutPlugin::setup()
 {
   this->gameState = this->GAME_STATE_END;
+  building.reset();
 }
 
-void BreakoutPlugin::loop()
+void BreakoutPlugin::tick(uint32_t now, uint32_t dt)
 {
   switch (this->gameState)
   {
   case this->GAME_STATE_LEVEL:
-    this->newLevel();
+    this->initBricks();
     break;
   case this->GAME_STATE_RUNNING:
+    // the game moves at an uneven pace, every 100 to 200 ms
+    if ((long)(millis() - this->nextStepMs) < 0)
+    {
+      break;
+    }
+    this->nextStepMs = millis() + random(100, 200);
     this->updateBall();
     this->updatePaddle();
-    delay(random(100, 200));
     break;
   case this->GAME_STATE_END:
     this->initGame();
@@ -209,6 +219,11 @@ void BreakoutPlugin::loop()
   }
 }
 
+uint16_t BreakoutPlugin::getFramePeriod() const
+{
+  return 25;
+}
+
 const char *BreakoutPlugin::getName() const
 {
   return "Breakout";
@@ -20,11 +20,11 @@ void ClockPlugin::loop()
   {
     if (previousHour != timeinfo.tm_hour || previousMinutes != timeinfo.tm_min)
     {
-      Screen.beginUpdate();
+      Screen.beginFrame();
       Screen.clear();
       Screen.drawNumbers(3, 2, {(timeinfo.tm_hour - timeinfo.tm_hour % 10) / 10, timeinfo.tm_hour % 10});
       Screen.drawNumbers(3, 8, {(timeinfo.tm_min - timeinfo.tm_min % 10) / 10, timeinfo.tm_min % 10});
-      Screen.endUpdate();
+      Screen.present();
     }
 
     previousMinutes = timeinfo.tm_min;
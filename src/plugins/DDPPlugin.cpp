@@ -2,44 +2,53 @@
 
 void DDPPlugin::setup()
 {
+    receiver.reset();
+
 #ifdef ASYNC_UDP_ENABLED
-    udp = new AsyncUDP();
-    if (udp->listen(4048))
+    if (!udp)
+    {
+        udp = new AsyncUDP();
+        udp->onPacket([this](AsyncUDPPacket packet)
+                      { onPacket(packet.data(), packet.length()); });
+    }
+    listening = true;
+    if (udp->listen(DDP_PORT))
     {
         Serial.print("DDP server listening at port: 4048");
-
-        udp->onPacket([](AsyncUDPPacket packet)
-                      {
-            if (packet.length() >= 10) {  // Basic DDP header check
-                const uint8_t* data = packet.data() + 10;  // Skip header
-                const size_t dataLength = packet.length() - 10;
-                int count = std::min((int)(dataLength / 3), ROWS * COLS);  // Each pixel is RGB
-
-                if (count == 1) {  // Single pixel mode
-                    uint8_t brightness = (data[0] + data[1] + data[2]) / 3;
-                    for (int i = 0; i < ROWS * COLS; i++) {
-                        Screen.setPixelAtIndex(i, brightness > 4, brightness);
-                    }
-                } else {  // Full pixel mapping
-                    for (int i = 0; i < count; i++) {
-                        uint8_t brightness = (data[i * 3] + data[i * 3 + 1] + data[i * 3 + 2]) / 3;
-                        Screen.setPixelAtIndex(i, brightness > 4, brightness);
-                    }
-                }
-            } });
     }
 #endif
 }
 
+// runs on the UDP task
+void DDPPlugin::onPacket(const uint8_t *data, size_t length)
+{
+    // counted before listening is checked, see teardown()
+    receiving++;
+    if (listening && receiver.receive(data, length))
+    {
+        // pixels not covered by a packet keep their last value
+        Ingest.submit(receiver.getFormat(), receiver.getChannels(), receiver.getFrameSize());
+    }
+    receiving--;
+}
+
 void DDPPlugin::teardown()
 {
+    listening = false;
 #ifdef ASYNC_UDP_ENABLED
     if (udp)
     {
-        delete udp;
-        udp = nullptr;
+        udp->close();
     }
 #endif
+    // a handler that started before listening went false may still be
+    // converting, one that starts later returns right away
+    while (receiving)
+    {
+        delay(1);
+    }
+    Ingest.reset();
+    Screen.hideLayer(LAYER_STREAM);
 }
 
 void DDPPlugin::loop()
@@ -47,7 +56,19 @@ void DDPPlugin::loop()
     delay(1);
 }
 
+void DDPPlugin::addStats(JsonObject object)
+{
+    const DDPStats &stats = receiver.stats;
+    object["packets"] = stats.packets;
+    object["frames"] = stats.frames;
+    object["malformed"] = stats.malformed;
+    object["outOfOrder"] = stats.outOfOrder;
+    object["staleFrames"] = stats.staleFrames;
+    object["packetsPerSecond"] = stats.packetsPerSecond;
+    object["framesPerSecond"] = stats.framesPerSecond;
+}
+
 const char *DDPPlugin::getName() const
 {
     return "DDP";
-}
\ No newline at end of file
+}
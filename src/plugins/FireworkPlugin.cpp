@@ -1,76 +1,71 @@
 #include "plugins/FireworkPlugin.h"
+#include "effects.h"
 
 void FireworkPlugin::drawExplosion(int x, int y, int maxRadius, int brightness)
 {
-  for (int i = 0; i < 16; i++)
+  // round(sqrt(d)) <= r is the same as d <= r * r + r for integers
+  int limit = maxRadius * maxRadius + maxRadius;
+  for (int j = y - maxRadius; j <= y + maxRadius; j++)
   {
-    for (int j = 0; j < 16; j++)
+    for (int i = x - maxRadius; i <= x + maxRadius; i++)
     {
-      int distance = round(sqrt(pow(i - x, 2) + pow(j - y, 2)));
-      if (distance <= maxRadius)
+      if ((i - x) * (i - x) + (j - y) * (j - y) <= limit)
       {
-        Screen.setPixel(i, j, 1, brightness);
+        canvas.setPixel(i, j, brightness);
       }
     }
   }
-}
-
-void FireworkPlugin::explode(int x, int y)
-{
-  int maxRadius = random(3, 6);
-
-  for (int radius = 1; radius <= maxRadius; radius++)
-  {
-    drawExplosion(x, y, radius, 255);
-    delay(explosionDelay);
-  }
-
-  for (int brightness = 248; brightness >= 0; brightness -= 8)
-  {
-    drawExplosion(x, y, maxRadius, brightness);
-    delay(fadeDelay);
-  }
+  Screen.present(canvas);
 }
 
 void FireworkPlugin::setup()
 {
+  canvas.clear();
   Screen.clear();
+  show.reset();
 }
 
-void FireworkPlugin::loop()
+void FireworkPlugin::tick(uint32_t now, uint32_t dt)
 {
-  static int rocketY = 16;
-  static int rocketX = 0;
-  static bool rocketLaunched = false;
+  CO_BEGIN(show);
 
-  unsigned long currentMillis = millis();
-
-  if (!rocketLaunched)
+  // the rocket climbs to a random height
+  rocketY = 16;
+  for (;;)
   {
-    if (currentMillis - previousMillis >= rocketDelay)
+    canvas.clear();
+    canvas.setPixel(rocketX, rocketY, 255);
+    Screen.present(canvas);
+    rocketY--;
+    if (rocketY < random(8))
     {
-      previousMillis = currentMillis;
-      Screen.clear();
-      Screen.setPixel(rocketX, rocketY, 1, 255);
-      rocketY--;
-
-      if (rocketY < random(8))
-      {
-        rocketLaunched = true;
-        explode(rocketX, rocketY);
-      }
+      break;
     }
+    CO_SLEEP(show, rocketDelay);
   }
-  else
+
+  // explode
+  maxRadius = random(3, 6);
+  for (radius = 1; radius <= maxRadius; radius++)
   {
-    if (currentMillis - previousMillis >= explosionDuration)
-    {
-      rocketY = 16;
-      rocketX = random(16);
-      rocketLaunched = false;
-      previousMillis = currentMillis;
-    }
+    drawExplosion(rocketX, rocketY, radius, 255);
+    CO_SLEEP(show, explosionDelay);
   }
+
+  for (fadeStep = 0; fadeStep < 32; fadeStep++)
+  {
+    Effects::decay(canvas.pixels, 8);
+    Screen.present(canvas);
+    CO_SLEEP(show, fadeDelay);
+  }
+
+  rocketX = random(16);
+  CO_END(show);
+}
+
+uint16_t FireworkPlugin::getFramePeriod() const
+{
+  return 12;
 }
 
 const char *FireworkPlugin::getName() const
@@ -48,7 +48,6 @@ void GameOfLifePlugin::setup()
 
 void GameOfLifePlugin::next()
 {
-  Screen.clear();
   for (int i = 0; i < ROWS; i++)
   {
     for (int j = 0; j < COLS; j++)
@@ -59,19 +58,13 @@ void GameOfLifePlugin::next()
 }
 
 int generations = 30;
-void GameOfLifePlugin::loop()
+void GameOfLifePlugin::tick(uint32_t now, uint32_t dt)
 {
   generations--;
   this->next();
 
-  for (int i = 0; i < ROWS; i++)
-  {
-    for (int j = 0; j < COLS; j++)
-    {
-      Screen.setPixelAtIndex(i * COLS + j, this->buffer[i * COLS + j]);
-    }
-  }
-  delay(150);
+  // cells are 0 or 1, one commit for the whole generation
+  Screen.setRenderBuffer(this->buffer);
 
   if (generations == 0)
   {
@@ -80,6 +73,11 @@ void GameOfLifePlugin::loop()
   }
 };
 
+uint16_t GameOfLifePlugin::getFramePeriod() const
+{
+  return 150;
+}
+
 const char *GameOfLifePlugin::getName() const
 {
   return "GameOfLife";
@@ -1,27 +1,35 @@
 #include "plugins/LinesPlugin.h"
 
+static const uint8_t lineFrames[][2] PROGMEM = {
+    {0xcc, 0xcc},
+    {0x66, 0x66},
+    {0x33, 0x33},
+    {0x99, 0x99}};
+
 void LinesPlugin::setup()
 {
   this->count = 0;
 }
 
-void LinesPlugin::loop()
+void LinesPlugin::tick(uint32_t now, uint32_t dt)
 {
-  std::vector<int> bits = Screen.readBytes(this->frames[this->count]);
+  Screen.beginFrame();
   for (int row = 0; row < ROWS; row++)
   {
-    for (int col = 0; col < bits.size(); col++)
-    {
-      Screen.setPixel(col, row, bits[col]);
-    }
+    Screen.drawGlyph(0, row, Glyph{lineFrames[this->count], 16, 1});
   }
+  Screen.present();
 
   this->count++;
   if (this->count >= 4)
   {
     this->count = 0;
   }
-  delay(200);
+}
+
+uint16_t LinesPlugin::getFramePeriod() const
+{
+  return 200;
 }
 
 const char *LinesPlugin::getName() const
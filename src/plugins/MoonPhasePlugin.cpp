@@ -16,11 +16,10 @@ void MoonPhasePlugin::loop() {
 }
 
 void MoonPhasePlugin::renderLoading() {
-  Screen.beginUpdate();
-  Screen.clear();
+  Canvas canvas;
   // simple loading dot
-  Screen.setPixel(8,8,1,80);
-  Screen.endUpdate();
+  canvas.setPixel(8,8,80);
+  Screen.present(canvas);
 }
 
 // Helper to classify into 8 textual phases if needed elsewhere
@@ -74,8 +73,7 @@ void MoonPhasePlugin::renderPhase() {
   float dshift = fabsf(2.0f * f - 1.0f) * R; // 0..R
   int shift = (int)(dshift + 0.5f);
 
-  Screen.beginUpdate();
-  Screen.clear();
+  Canvas canvas;
 
   for (int y = 0; y < 16; ++y) {
     for (int x = 0; x < 16; ++x) {
@@ -86,11 +84,11 @@ void MoonPhasePlugin::renderPhase() {
       if (!inBase) continue;
 
       // Draw shadow (dark side) first to indicate full disc
-      Screen.setPixel(x, y, 1, BRIGHT_SHADOW);
+      canvas.setPixel(x, y, BRIGHT_SHADOW);
 
       if (f <= 0.0f) continue;       // new moon: leave as shadow
       if (f >= 1.0f) {               // full moon: brighten all inside
-        Screen.setPixel(x, y, 1, BRIGHT_LIT);
+        canvas.setPixel(x, y, BRIGHT_LIT);
         continue;
       }
 
@@ -111,11 +109,11 @@ void MoonPhasePlugin::renderPhase() {
         lit = !(dd_c <= R*R);
       }
 
-      if (lit) Screen.setPixel(x, y, 1, BRIGHT_LIT);
+      if (lit) canvas.setPixel(x, y, BRIGHT_LIT);
     }
   }
 
-  Screen.endUpdate();
+  Screen.present(canvas);
 }
 
 const char* MoonPhasePlugin::getName() const { return "Moon Phase"; }
@@ -9,22 +9,6 @@
 *************************************************/
 static const uint8_t Y_MIN = 6;
 
-void PongClockPlugin::drawCharacter(int x, int y, std::vector<int> bits, int bitCount, uint8_t brightness)
-{
-  for (int i = 0; i < bits.size(); i += bitCount)
-  {
-    for (int j = 0; j < bitCount; j++)
-    {
-      int xPos = (x + j - 1);
-      int yPos = y + (i / bitCount);
-      if (xPos >= 0 && xPos < X_MAX && yPos >= 0 && yPos < Y_MAX)
-      {
-        Screen.setPixel(xPos, yPos, bits[i + j], brightness);
-      }
-    }
-  }
-}
-
 long PongClockPlugin::realRandom(int max)
 {
   if (0 == max)
@@ -47,10 +31,10 @@ int PongClockPlugin::realRandom(int min, int max)
 void PongClockPlugin::drawDigits()
 {
   // Digits very bright
-  drawCharacter(0, 0, Screen.readBytes(smallNumbers[(current_hour - current_hour % 10) / 10]), 4, 255);
-  drawCharacter(4, 0, Screen.readBytes(smallNumbers[current_hour % 10]), 4, 255);
-  drawCharacter(9, 0, Screen.readBytes(smallNumbers[(current_minute - current_minute % 10) / 10]), 4, 255);
-  drawCharacter(13, 0, Screen.readBytes(smallNumbers[current_minute % 10]), 4, 255);
+  Screen.drawGlyph(-1, 0, smallNumber((current_hour - current_hour % 10) / 10), 255);
+  Screen.drawGlyph(3, 0, smallNumber(current_hour % 10), 255);
+  Screen.drawGlyph(8, 0, smallNumber((current_minute - current_minute % 10) / 10), 255);
+  Screen.drawGlyph(12, 0, smallNumber(current_minute % 10), 255);
 }
 
 float PongClockPlugin::degToRad(float deg)
@@ -217,9 +201,9 @@ void PongClockPlugin::loop()
     // clear screen and draw time
     if (previousHour != timeinfo.tm_hour || previousMinutes != timeinfo.tm_min)
     {
-      Screen.beginUpdate();
+      Screen.beginFrame();
       drawDigits();
-      Screen.endUpdate();
+      Screen.present();
     }
 
     if (!pongCelebrate)
@@ -1,7 +1,13 @@
 #include "plugins/RainPlugin.h"
+#include "effects.h"
+
+// trail steps: above 75 -> 64, above 50 -> 32, above 25 -> 16, else off
+static const uint8_t trailThresholds[] = {25, 50, 75};
+static const uint8_t trailValues[] = {16, 32, 64};
 
 void RainPlugin::setup()
 {
+  canvas.clear();
   Screen.clear();
   for (byte i = 0; i < RainPlugin::RainPlugin::NUM_DROPS; i++)
     for (unsigned char i = 0; i < RainPlugin::RainPlugin::NUM_DROPS; i++)
@@ -12,27 +18,10 @@ void RainPlugin::setup()
     }
 }
 
-void RainPlugin::loop()
+void RainPlugin::tick(uint32_t now, uint32_t dt)
 {
   // dim the trail
-  for (uint8_t x = 0; x < RainPlugin::X_MAX; x++)
-  {
-    for (uint8_t y = 0; y < RainPlugin::Y_MAX; y++)
-    {
-      uint8_t brightness = Screen.getBufferIndex(y * RainPlugin::X_MAX + x);
-
-      if (brightness <= 25)
-        brightness = 0;
-      else if (brightness <= 50)
-        brightness = 16;
-      else if (brightness <= 75)
-        brightness = 32;
-      else
-        brightness = 64;
-
-      Screen.setPixel(x, y, 1, brightness);
-    }
-  }
+  Effects::quantize(canvas.pixels, trailThresholds, trailValues, 3);
 
   // draw the drops
   for (unsigned char i = 0; i < RainPlugin::NUM_DROPS; i++)
@@ -46,7 +35,7 @@ void RainPlugin::loop()
       this->drops[i].y = 0;
       this->drops[i].visible = true;
 
-      Screen.setPixel(this->drops[i].x, this->drops[i].y, RainPlugin::LED_TYPE_ON, 255);
+      canvas.setPixel(this->drops[i].x, this->drops[i].y, 255);
     }
     else
     {
@@ -56,11 +45,16 @@ void RainPlugin::loop()
         this->drops[i].visible = false;
         continue;
       }
-      Screen.setPixel(this->drops[i].x, this->drops[i].y, RainPlugin::LED_TYPE_ON, 255);
+      canvas.setPixel(this->drops[i].x, this->drops[i].y, 255);
     }
   }
 
-  delay(96);
+  Screen.present(canvas);
+}
+
+uint16_t RainPlugin::getFramePeriod() const
+{
+  return 96;
 }
 
 const char *RainPlugin::getName() const
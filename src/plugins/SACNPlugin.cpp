@@ -0,0 +1,68 @@
+#include "plugins/SACNPlugin.h"
+
+void SACNPlugin::setup()
+{
+    receiver.configure(startUniverse, channelsPerPixel);
+    receiver.open();
+}
+
+void SACNPlugin::teardown()
+{
+    receiver.close();
+    Ingest.reset();
+    Screen.hideLayer(LAYER_STREAM);
+}
+
+void SACNPlugin::loop()
+{
+    // everything waiting since the last call, only the newest complete frame
+    // is shown
+    receiver.poll();
+
+    DmxFrame &frame = receiver.frame;
+    uint32_t completeUs;
+    if (const uint8_t *pixels = frame.take(completeUs))
+    {
+        Ingest.submit(frame.getFormat(), pixels, IngestKernels::frameSize(frame.getFormat()), completeUs);
+    }
+}
+
+void SACNPlugin::addStats(JsonObject object)
+{
+    const SACNStats &stats = receiver.stats;
+    object["startUniverse"] = receiver.getStartUniverse();
+    object["universes"] = receiver.frame.getUniverses();
+    object["channelsPerPixel"] = channelsPerPixel;
+    object["syncAddress"] = receiver.getSyncAddress();
+    object["synchronous"] = receiver.isSynchronous(millis());
+    object["packets"] = stats.packets;
+    object["ignored"] = stats.ignored;
+    object["malformed"] = stats.malformed;
+    object["lowerPriority"] = stats.lowerPriority;
+    object["outOfOrder"] = stats.outOfOrder;
+    object["sourceChanges"] = stats.sourceChanges;
+    object["syncs"] = stats.syncs;
+    object["frames"] = receiver.frame.frames;
+    object["stale"] = receiver.frame.stale;
+    object["queueDepth"] = stats.queueDepth;
+    object["maxQueueDepth"] = stats.maxQueueDepth;
+}
+
+void SACNPlugin::websocketHook(DynamicJsonDocument &request)
+{
+    const char *event = request["event"];
+
+    if (currentStatus == NONE && !strcmp(event, "sacn"))
+    {
+        receiver.close();
+        receiver.configure(request["universe"] | startUniverse, request["channels"] | channelsPerPixel);
+        startUniverse = receiver.getStartUniverse();
+        channelsPerPixel = receiver.frame.getChannelsPerPixel();
+        receiver.open();
+    }
+}
+
+const char *SACNPlugin::getName() const
+{
+    return "sACN";
+}
@@ -193,7 +193,7 @@ void SnakePlugin::findDirection()
     else
     {
       // killed yourself - no possible directions
-      end();
+      this->gameState = SnakePlugin::GAME_STATE_DYING;
     }
   }
   else if (bestway_up > bestway_right && bestway_up > bestway_down && bestway_up > bestway_left)
@@ -268,67 +268,48 @@ void SnakePlugin::moveSnake(uint newpos)
 
 void SnakePlugin::end()
 {
-  for (const int &n : this->position)
-  {
-    Screen.setPixelAtIndex(n, SnakePlugin::LED_TYPE_OFF);
-  }
-  delay(200);
-
-  for (const int &n : this->position)
-  {
-    Screen.setPixelAtIndex(n, SnakePlugin::LED_TYPE_ON);
-  }
-  delay(200);
-
-  for (const int &n : this->position)
-  {
-    Screen.setPixelAtIndex(n, SnakePlugin::LED_TYPE_OFF);
-  }
-  delay(200);
-
-  for (const int &n : this->position)
-  {
-    Screen.setPixelAtIndex(n, SnakePlugin::LED_TYPE_ON);
-  }
-  delay(200);
-
-  for (const int &n : this->position)
-  {
-    Screen.setPixelAtIndex(n, SnakePlugin::LED_TYPE_OFF);
-  }
-  delay(200);
+  CO_BEGIN(dying);
 
-  for (const int &n : this->position)
+  // blink three times
+  for (blink = 0; blink < 6; blink++)
   {
-    Screen.setPixelAtIndex(n, SnakePlugin::LED_TYPE_ON);
+    for (const uint &n : this->position)
+    {
+      Screen.setPixelAtIndex(n, blink % 2 ? SnakePlugin::LED_TYPE_ON : SnakePlugin::LED_TYPE_OFF);
+    }
+    CO_SLEEP(dying, blink == 5 ? 500 : 200);
   }
-  delay(500);
 
-  for (const int &n : this->position)
+  // then take it away from the tail
+  for (segment = 0; segment < this->position.size(); segment++)
   {
-    Screen.setPixelAtIndex(n, SnakePlugin::LED_TYPE_OFF);
-    delay(200);
+    Screen.setPixelAtIndex(this->position[segment], SnakePlugin::LED_TYPE_OFF);
+    CO_SLEEP(dying, 200);
   }
 
-  delay(200);
+  CO_SLEEP(dying, 200);
   Screen.setPixelAtIndex(this->dot, SnakePlugin::LED_TYPE_OFF);
-  delay(500);
+  CO_SLEEP(dying, 500);
 
   this->gameState = SnakePlugin::GAME_STATE_END;
+  CO_END(dying);
 }
 
 void SnakePlugin::setup()
 {
   this->gameState = SnakePlugin::GAME_STATE_END;
+  dying.reset();
 }
 
-void SnakePlugin::loop()
+void SnakePlugin::tick(uint32_t now, uint32_t dt)
 {
   switch (this->gameState)
   {
   case SnakePlugin::GAME_STATE_RUNNING:
     this->findDirection();
-    delay(100);
+    break;
+  case SnakePlugin::GAME_STATE_DYING:
+    this->end();
     break;
   case SnakePlugin::GAME_STATE_END:
     this->initGame();
@@ -336,6 +317,11 @@ void SnakePlugin::loop()
   }
 }
 
+uint16_t SnakePlugin::getFramePeriod() const
+{
+  return 100;
+}
+
 const char *SnakePlugin::getName() const
 {
   return "Snake";
@@ -1,54 +1,35 @@
 #include "plugins/StarsPlugin.h"
+#include "effects.h"
 
 void StarsPlugin::setup()
 {
   numStars = 25;
+  canvas.clear();
   for (int i = 0; i < numStars; i++)
   {
     stars[i].x = random(0, 16);
     stars[i].y = random(0, 16);
-    stars[i].brightness = random(255);
-    stars[i].lastUpdateTime = millis();
+    canvas.setPixel(stars[i].x, stars[i].y, random(255));
   }
+  Screen.present(canvas);
 }
 
-void StarsPlugin::loop()
+void StarsPlugin::tick(uint32_t now, uint32_t dt)
 {
-  for (int fadeStep = 255; fadeStep >= 0; fadeStep -= 4)
+  // every star fades by the same step, so the whole sky is dimmed at once
+  Effects::decay(canvas.pixels, 8);
+
+  for (int i = 0; i < numStars; i++)
   {
-    yield();
-    for (int i = 0; i < numStars; i++)
+    if (canvas.getPixel(stars[i].x, stars[i].y) == 0)
     {
-      if (stars[i].brightness > 0)
-      {
-        unsigned long currentTime = millis();
-        if (currentTime - stars[i].lastUpdateTime >= 128)
-        {
-          stars[i].brightness = max(0, stars[i].brightness - 8);
-          Screen.setPixel(stars[i].x, stars[i].y, 1, stars[i].brightness);
-          stars[i].lastUpdateTime = currentTime;
-        }
-      }
-      else
-      {
-        stars[i].x = random(0, 16);
-        stars[i].y = random(0, 16);
-        stars[i].brightness = random(8, 255);
-
-        for (int brightness = 0; brightness <= stars[i].brightness; brightness += 5)
-        {
-          unsigned long currentTime = millis();
-          if (currentTime - stars[i].lastUpdateTime >= 64)
-          {
-            Screen.setPixel(stars[i].x, stars[i].y, 1, brightness);
-            stars[i].lastUpdateTime = currentTime;
-          }
-          yield();
-        }
-      }
+      stars[i].x = random(0, 16);
+      stars[i].y = random(0, 16);
+      canvas.setPixel(stars[i].x, stars[i].y, random(8, 255));
     }
-    delay(1);
   }
+
+  Screen.present(canvas);
 }
 
 void StarsPlugin::teardown()
@@ -57,6 +38,11 @@ void StarsPlugin::teardown()
   Screen.clear();
 }
 
+uint16_t StarsPlugin::getFramePeriod() const
+{
+  return 128;
+}
+
 const char *StarsPlugin::getName() const
 {
   return "Stars";
@@ -3,12 +3,11 @@
 
 static void drawChart(){
   const StockData &d = StockService::getInstance().get();
-  Screen.beginUpdate();
-  Screen.clear();
+  Canvas canvas;
   if (!d.valid || d.count==0){
     // simple loading shimmer
-    for (int i=0;i<16;i++) Screen.setPixel(i,15-(i%3),1,80);
-    Screen.endUpdate();
+    for (int i=0;i<16;i++) canvas.setPixel(i,15-(i%3),80);
+    Screen.present(canvas);
     return;
   }
   // find min/max; guard against outliers by using last N only
@@ -19,8 +18,8 @@ static void drawChart(){
   if (mx==mn) mx=mn+1.0f;
   // map to 16x16: use last up to 16 points across width
   // draw grid (faint)
-  for (int y=0;y<16;y+=4) for (int x=0;x<16;x++) Screen.setPixel(x,y,1,20);
-  for (int x=0;x<16;x+=4) for (int y=0;y<16;y++) Screen.setPixel(x,y,1,20);
+  for (int y=0;y<16;y+=4) canvas.fillSpan(0,y,16,20);
+  for (int x=0;x<16;x+=4) canvas.drawVLine(x,0,15,20);
 
   int m = n; // points to draw
   int prevx=-1, prevy=-1;
@@ -30,18 +29,17 @@ static void drawChart(){
     float t = (v - mn)/(mx - mn);
     int y = 15 - (int)roundf(t * 15.0f);
     if (x>=0 && x<16 && y>=0 && y<16){
-      Screen.setPixel(x,y,1,220);
+      canvas.setPixel(x,y,220);
       if (prevx>=0){
         // simple vertical connect to show trend
-        int y0=min(prevy,y), y1=max(prevy,y);
-        for (int yy=y0; yy<=y1; ++yy) Screen.setPixel(x,yy,1,120);
+        canvas.drawVLine(x,prevy,y,120);
       }
       prevx=x; prevy=y;
     }
   }
   // baseline
-  for (int x=0;x<16;x++) Screen.setPixel(x,15,1,30);
-  Screen.endUpdate();
+  canvas.fillSpan(0,15,16,30);
+  Screen.present(canvas);
 }
 
 void StockChartPlugin::loop(){
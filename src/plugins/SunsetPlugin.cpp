@@ -16,7 +16,7 @@ void SunsetPlugin::loop() {
 }
 
 void SunsetPlugin::render(int minutes) {
-  Screen.beginUpdate();
+  Screen.beginFrame();
   Screen.clear();
 
   // Icon über gesamte Breite (16×16)
@@ -40,10 +40,10 @@ void SunsetPlugin::render(int minutes) {
     int mOnes = (mm % 10);
 
     // Startpositionen: -1, 3, 8, 12 (entspricht PongClock 0,4,9,13 mit -1 Shift)
-    Screen.drawCharacter(-1, yBase, Screen.readBytes(smallNumbers[hTens]), 4, 255);
-    Screen.drawCharacter( 3, yBase, Screen.readBytes(smallNumbers[hOnes]), 4, 255);
-    Screen.drawCharacter( 8, yBase, Screen.readBytes(smallNumbers[mTens]), 4, 255);
-    Screen.drawCharacter(12, yBase, Screen.readBytes(smallNumbers[mOnes]), 4, 255);
+    Screen.drawGlyph(-1, yBase, smallNumber(hTens), 255);
+    Screen.drawGlyph( 3, yBase, smallNumber(hOnes), 255);
+    Screen.drawGlyph( 8, yBase, smallNumber(mTens), 255);
+    Screen.drawGlyph(12, yBase, smallNumber(mOnes), 255);
   } else {
     // Kein Wert: dezenter Platzhalter unten mittig
     Screen.setPixel(7, 12, 1);
@@ -51,7 +51,7 @@ void SunsetPlugin::render(int minutes) {
     Screen.setPixel(9, 12, 1);
   }
 
-  Screen.endUpdate();
+  Screen.present();
 }
 
 void SunsetPlugin::drawSunsetIcon(int x, int y) {
@@ -224,14 +224,13 @@ void TetrisDemoPlugin::chooseBestPlacement(uint8_t pieceType, uint8_t &bestRot,
 }
 
 void TetrisDemoPlugin::render() {
-  Screen.beginUpdate();
-  Screen.clear();
+  Canvas canvas;
 
   // draw fixed board (visible part rows 4..19 at y 0..15)
   for (int y=VIS_Y_OFFSET; y<BOARD_H; ++y) {
     for (int x=0; x<BOARD_W; ++x) {
       if (board_[y][x]) {
-        Screen.setPixel(3+x, y-VIS_Y_OFFSET, 1, BRIGHT_FIXED);
+        canvas.setPixel(3+x, y-VIS_Y_OFFSET, BRIGHT_FIXED);
       }
     }
   }
@@ -239,7 +238,7 @@ void TetrisDemoPlugin::render() {
   // line clear blink
   if (clearing_) {
     for (int y=VIS_Y_OFFSET; y<BOARD_H; ++y) if (clearRows_[y]) {
-      for (int x=0; x<BOARD_W; ++x) Screen.setPixel(3+x, y-VIS_Y_OFFSET, 1, 255);
+      canvas.fillSpan(3, y-VIS_Y_OFFSET, BOARD_W, 255);
     }
   }
 
@@ -249,7 +248,7 @@ void TetrisDemoPlugin::render() {
     if (mask & (1 << ((3-dy)*4 + (3-dx)))) {
       int px = active_.x + dx;
       int py = active_.y + dy;
-      if (py>=VIS_Y_OFFSET) Screen.setPixel(3+px, py-VIS_Y_OFFSET, 1, BRIGHT_ACTIVE);
+      if (py>=VIS_Y_OFFSET) canvas.setPixel(3+px, py-VIS_Y_OFFSET, BRIGHT_ACTIVE);
     }
   }
 
@@ -260,10 +259,10 @@ void TetrisDemoPlugin::render() {
     int py = 1 + dy;
     if (px < 13) px = 13;
     if (px > 15) px = 15;
-    if (py>=0 && py<16) Screen.setPixel(px, py, 1, BRIGHT_UI);
+    if (py>=0 && py<16) canvas.setPixel(px, py, BRIGHT_UI);
   }
 
-  Screen.endUpdate();
+  Screen.present(canvas);
 }
 
 void TetrisDemoPlugin::setup() {
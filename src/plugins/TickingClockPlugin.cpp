@@ -21,18 +21,17 @@ void TickingClockPlugin::loop()
     if (previousHour != timeinfo.tm_hour || previousMinutes != timeinfo.tm_min)
     {
 
-      std::vector<int> hh = {(timeinfo.tm_hour - timeinfo.tm_hour % 10) / 10, timeinfo.tm_hour % 10};
-      std::vector<int> mm = {(timeinfo.tm_min - timeinfo.tm_min % 10) / 10, timeinfo.tm_min % 10};
+      const Font &font = getFont(FONT_BOLD_NUMBER);
 
-      Screen.beginUpdate();
+      Screen.beginFrame();
       Screen.clear();
 
       // Digits bright
-      Screen.drawCharacter(2, 0, Screen.readBytes(fonts[1].data[hh[0]]), 8, 255);
-      Screen.drawCharacter(9, 0, Screen.readBytes(fonts[1].data[hh[1]]), 8, 255);
-      Screen.drawCharacter(2, 9, Screen.readBytes(fonts[1].data[mm[0]]), 8, 255);
-      Screen.drawCharacter(9, 9, Screen.readBytes(fonts[1].data[mm[1]]), 8, 255);
-      Screen.endUpdate();
+      Screen.drawGlyph(2, 0, font.glyph('0' + timeinfo.tm_hour / 10), 255);
+      Screen.drawGlyph(9, 0, font.glyph('0' + timeinfo.tm_hour % 10), 255);
+      Screen.drawGlyph(2, 9, font.glyph('0' + timeinfo.tm_min / 10), 255);
+      Screen.drawGlyph(9, 9, font.glyph('0' + timeinfo.tm_min % 10), 255);
+      Screen.present();
       previousMinutes = timeinfo.tm_min;
       previousHour = timeinfo.tm_hour;
     }
@@ -66,43 +66,43 @@ void WeatherPlugin::update()
             weatherIcon = 0;
         }
 
-        Screen.beginUpdate();
+        Screen.beginFrame();
         Screen.clear();
         Screen.drawWeather(0, iconY, weatherIcon, 100);
 
         int temperature = d.tempC;
         if (temperature >= 10)
         {
-            Screen.drawCharacter(9, tempY, Screen.readBytes(degreeSymbol), 4, 50);
+            Screen.drawGlyph(9, tempY, degreeSymbol, 50);
             Screen.drawNumbers(1, tempY, {(temperature - temperature % 10) / 10, temperature % 10});
         }
         else if (temperature <= -10)
         {
-            Screen.drawCharacter(0, tempY, Screen.readBytes(minusSymbol), 4);
-            Screen.drawCharacter(11, tempY, Screen.readBytes(degreeSymbol), 4, 50);
+            Screen.drawGlyph(0, tempY, minusSymbol);
+            Screen.drawGlyph(11, tempY, degreeSymbol, 50);
             temperature *= -1;
             Screen.drawNumbers(3, tempY, {(temperature - temperature % 10) / 10, temperature % 10});
         }
         else if (temperature >= 0)
         {
-            Screen.drawCharacter(7, tempY, Screen.readBytes(degreeSymbol), 4, 50);
+            Screen.drawGlyph(7, tempY, degreeSymbol, 50);
             Screen.drawNumbers(4, tempY, {temperature});
         }
         else
         {
-            Screen.drawCharacter(0, tempY, Screen.readBytes(minusSymbol), 4);
-            Screen.drawCharacter(9, tempY, Screen.readBytes(degreeSymbol), 4, 50);
+            Screen.drawGlyph(0, tempY, minusSymbol);
+            Screen.drawGlyph(9, tempY, degreeSymbol, 50);
             Screen.drawNumbers(3, tempY, {-temperature});
         }
-        Screen.endUpdate();
+        Screen.present();
     }
     else
     {
         // show loading indicator if no data yet
-        Screen.beginUpdate();
+        Screen.beginFrame();
         Screen.clear();
-        Screen.drawCharacter(3, 7, Screen.readBytes(degreeSymbol), 4, 20);
-        Screen.endUpdate();
+        Screen.drawGlyph(3, 7, degreeSymbol, 20);
+        Screen.present();
     }
 }
 
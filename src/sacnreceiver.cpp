@@ -0,0 +1,292 @@
+#include "sacnreceiver.h"
+
+namespace
+{
+  const uint8_t ACN_IDENTIFIER[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
+
+  inline uint16_t read16(const uint8_t *data)
+  {
+    return data[0] << 8 | data[1];
+  }
+
+  inline uint32_t read32(const uint8_t *data)
+  {
+    return (uint32_t)data[0] << 24 | (uint32_t)data[1] << 16 | data[2] << 8 | data[3];
+  }
+
+  // sequence numbers within 20 behind the last one are late, further
+  // back the sender restarted
+  inline bool isLate(uint8_t sequence, uint8_t last)
+  {
+    int8_t ahead = sequence - last;
+    return ahead <= 0 && ahead > -20;
+  }
+}
+
+bool SACNReceiver::open(uint16_t port)
+{
+#ifdef SACN_SOCKETS_ENABLED
+  sock_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (sock_ < 0)
+  {
+    Serial.println("sACN: no socket");
+    return false;
+  }
+  int reuse = 1;
+  setsockopt(sock_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (bind(sock_, (sockaddr *)&address, sizeof(address)) < 0)
+  {
+    Serial.println("sACN: bind failed");
+    close();
+    return false;
+  }
+
+  for (uint8_t i = 0; i < frame.getUniverses(); i++)
+  {
+    join(startUniverse_ + i);
+  }
+  Serial.printf("sACN listening on port %d, universes %u - %u, %u channels per pixel\n",
+                port, startUniverse_, startUniverse_ + frame.getUniverses() - 1, frame.getChannelsPerPixel());
+  return true;
+#else
+  return false;
+#endif
+}
+
+void SACNReceiver::close()
+{
+#ifdef SACN_SOCKETS_ENABLED
+  if (sock_ >= 0)
+  {
+    // memberships end with the socket
+    ::close(sock_);
+    sock_ = -1;
+  }
+#endif
+  joinedSync_ = 0;
+}
+
+// every universe has its own group, 239.255.hi.lo
+void SACNReceiver::join(uint16_t universe)
+{
+#ifdef SACN_SOCKETS_ENABLED
+  ip_mreq group = {};
+  group.imr_multiaddr.s_addr = htonl(0xEFFF0000 | universe);
+  group.imr_interface.s_addr = htonl(INADDR_ANY);
+  setsockopt(sock_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &group, sizeof(group));
+#endif
+}
+
+void SACNReceiver::leave(uint16_t universe)
+{
+#ifdef SACN_SOCKETS_ENABLED
+  ip_mreq group = {};
+  group.imr_multiaddr.s_addr = htonl(0xEFFF0000 | universe);
+  group.imr_interface.s_addr = htonl(INADDR_ANY);
+  setsockopt(sock_, IPPROTO_IP, IP_DROP_MEMBERSHIP, &group, sizeof(group));
+#endif
+}
+
+void SACNReceiver::configure(uint16_t universe, uint8_t channelsPerPixel)
+{
+  // valid universes are 1 to 63999
+  startUniverse_ = constrain(universe, 1, 63999);
+  frame.configure(channelsPerPixel);
+  for (SACNSource &source : sources_)
+  {
+    source.active = false;
+  }
+  syncAddress_ = 0;
+  stats = SACNStats();
+}
+
+void SACNReceiver::poll()
+{
+#ifdef SACN_SOCKETS_ENABLED
+  if (sock_ < 0)
+  {
+    return;
+  }
+
+  uint8_t drained = 0;
+  while (drained < SACN_DRAIN_MAX)
+  {
+    int length = recv(sock_, packet_, sizeof(packet_), MSG_DONTWAIT);
+    if (length <= 0)
+    {
+      break;
+    }
+    drained++;
+    receive(length);
+  }
+  if (drained)
+  {
+    stats.queueDepth = drained;
+    stats.maxQueueDepth = max(stats.maxQueueDepth, drained);
+  }
+
+  // the synchronization universe of the data is joined while it is used
+  if (syncAddress_ != joinedSync_)
+  {
+    if (joinedSync_)
+    {
+      leave(joinedSync_);
+    }
+    if (syncAddress_)
+    {
+      join(syncAddress_);
+    }
+    joinedSync_ = syncAddress_;
+  }
+#endif
+}
+
+void SACNReceiver::receive(size_t length)
+{
+  // root layer
+  if (length < SACN_MIN_PACKET_SIZE || read16(packet_) != 0x0010 ||
+      memcmp(packet_ + 4, ACN_IDENTIFIER, sizeof(ACN_IDENTIFIER)))
+  {
+    stats.malformed++;
+    return;
+  }
+
+  switch (read32(packet_ + 18))
+  {
+  case SACN_ROOT_VECTOR_DATA:
+    receiveData(length);
+    break;
+  case SACN_ROOT_VECTOR_EXTENDED:
+    receiveSync(length);
+    break;
+  default:
+    // universe discovery and anything newer
+    stats.ignored++;
+    break;
+  }
+}
+
+void SACNReceiver::receiveData(size_t length)
+{
+  if (length < SACN_DATA_HEADER_SIZE || read32(packet_ + 40) != SACN_FRAMING_VECTOR_DATA ||
+      packet_[117] != 0x02 || packet_[118] != 0xA1)
+  {
+    stats.malformed++;
+    return;
+  }
+
+  uint16_t universe = read16(packet_ + 113);
+  uint8_t options = packet_[112];
+  uint16_t index = universe - startUniverse_;
+  // slot 0 is the start code, 0 for dimmer data
+  if (universe < startUniverse_ || index >= frame.getUniverses() ||
+      (options & SACN_OPTION_PREVIEW) || packet_[125] != 0)
+  {
+    stats.ignored++;
+    return;
+  }
+
+  unsigned long now = millis();
+  SACNSource &source = sources_[index];
+  const uint8_t *cid = packet_ + 22;
+  if (!acceptSource(source, cid, packet_[108], packet_[111], now))
+  {
+    return;
+  }
+
+  if (options & SACN_OPTION_TERMINATED)
+  {
+    // any other source may take over right away
+    source.active = false;
+    return;
+  }
+
+  uint16_t slots = read16(packet_ + 123) - 1;
+  slots = min((size_t)slots, length - SACN_DATA_HEADER_SIZE);
+  stats.packets++;
+  uint16_t syncAddress = read16(packet_ + 109);
+  if (syncAddress != syncAddress_)
+  {
+    // the first sync of a new synchronization universe is waited for
+    syncAddress_ = syncAddress;
+    lastSyncMs_ = now;
+  }
+  frame.write(index, packet_ + SACN_DATA_HEADER_SIZE, slots, isSynchronous(now));
+}
+
+bool SACNReceiver::acceptSource(SACNSource &source, const uint8_t *cid, uint8_t priority, uint8_t sequence, unsigned long now)
+{
+  bool same = source.active && !memcmp(source.cid, cid, sizeof(source.cid));
+  bool expired = !source.active || now - source.lastMs > SACN_TIMEOUT_MS;
+
+  if (!same)
+  {
+    // the highest priority wins, sources of equal priority are not
+    // merged, the first one keeps the universe
+    if (!expired && priority <= source.priority)
+    {
+      stats.lowerPriority++;
+      return false;
+    }
+    memcpy(source.cid, cid, sizeof(source.cid));
+    source.active = true;
+    stats.sourceChanges++;
+  }
+  else if (isLate(sequence, source.sequence))
+  {
+    stats.outOfOrder++;
+    return false;
+  }
+
+  source.priority = priority;
+  source.sequence = sequence;
+  source.lastMs = now;
+  return true;
+}
+
+void SACNReceiver::receiveSync(size_t length)
+{
+  if (length < SACN_SYNC_PACKET_SIZE || read32(packet_ + 40) != SACN_FRAMING_VECTOR_SYNC)
+  {
+    stats.malformed++;
+    return;
+  }
+
+  uint8_t sequence = packet_[44];
+  uint16_t address = read16(packet_ + 45);
+  if (!syncAddress_ || address != syncAddress_)
+  {
+    stats.ignored++;
+    return;
+  }
+  if (isLate(sequence, syncSequence_) && millis() - lastSyncMs_ < SACN_TIMEOUT_MS)
+  {
+    stats.outOfOrder++;
+    return;
+  }
+
+  syncSequence_ = sequence;
+  lastSyncMs_ = millis();
+  stats.syncs++;
+  frame.complete();
+}
+
+uint16_t SACNReceiver::getStartUniverse() const
+{
+  return startUniverse_;
+}
+
+uint16_t SACNReceiver::getSyncAddress() const
+{
+  return syncAddress_;
+}
+
+bool SACNReceiver::isSynchronous(unsigned long now) const
+{
+  return syncAddress_ && now - lastSyncMs_ < SACN_TIMEOUT_MS;
+}
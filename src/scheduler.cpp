@@ -1,4 +1,5 @@
 #include "scheduler.h"
+#include "commands.h"
 #include "websocket.h"
 #include <time.h>
 
@@ -93,10 +94,8 @@ void PluginScheduler::switchToCurrentPlugin()
 {
   if (currentIndex < schedule.size())
   {
-    pluginManager.setActivePluginById(schedule[currentIndex].pluginId);
-#ifdef ENABLE_SERVER
-    sendInfo();
-#endif
+    // sends the info once the plugin is active
+    Commands.post(CMD_SET_PLUGIN, schedule[currentIndex].pluginId);
   }
 }
 
@@ -1,12 +1,175 @@
 #include "screen.h"
+#include "subframes.h"
 #include <SPI.h>
 #include <algorithm>
 
-#define TIMER_INTERVAL_US 200
-#define GRAY_LEVELS 64 // must be a power of two
+#define IDLE_REFRESH_US 100000 // relatch interval while no pixel needs modulation
+#define MAX_GRAY_SHIFT 3       // the refresh profile never goes below 8 gray levels
+#define TUNE_SAMPLES 64        // refresh ticks measured per tuning run
+#define METRICS_BUCKET_CYCLES 128 // width of one interrupt duration histogram bucket
+
+#ifdef ENABLE_BCM_REFRESH
+#define SUBFRAMES BCM_PLANES
+#else
+#define SUBFRAMES GRAY_LEVELS
+#endif
+
+#ifndef DRAM_ATTR
+#define DRAM_ATTR
+#endif
 
 using namespace std;
 
+namespace
+{
+  // shift register position -> pixel index of the unrotated panel
+  constexpr uint8_t panelPositions[ROWS * COLS] = {
+      0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+      0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+      0x27, 0x26, 0x25, 0x24, 0x23, 0x22, 0x21, 0x20, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+      0x2f, 0x2e, 0x2d, 0x2c, 0x2b, 0x2a, 0x29, 0x28, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f,
+      0x4f, 0x4e, 0x4d, 0x4c, 0x4b, 0x4a, 0x49, 0x48, 0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f,
+      0x47, 0x46, 0x45, 0x44, 0x43, 0x42, 0x41, 0x40, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57,
+      0x67, 0x66, 0x65, 0x64, 0x63, 0x62, 0x61, 0x60, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77,
+      0x6f, 0x6e, 0x6d, 0x6c, 0x6b, 0x6a, 0x69, 0x68, 0x78, 0x79, 0x7a, 0x7b, 0x7c, 0x7d, 0x7e, 0x7f,
+      0x8f, 0x8e, 0x8d, 0x8c, 0x8b, 0x8a, 0x89, 0x88, 0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f,
+      0x87, 0x86, 0x85, 0x84, 0x83, 0x82, 0x81, 0x80, 0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+      0xa7, 0xa6, 0xa5, 0xa4, 0xa3, 0xa2, 0xa1, 0xa0, 0xb0, 0xb1, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7,
+      0xaf, 0xae, 0xad, 0xac, 0xab, 0xaa, 0xa9, 0xa8, 0xb8, 0xb9, 0xba, 0xbb, 0xbc, 0xbd, 0xbe, 0xbf,
+      0xcf, 0xce, 0xcd, 0xcc, 0xcb, 0xca, 0xc9, 0xc8, 0xd8, 0xd9, 0xda, 0xdb, 0xdc, 0xdd, 0xde, 0xdf,
+      0xc7, 0xc6, 0xc5, 0xc4, 0xc3, 0xc2, 0xc1, 0xc0, 0xd0, 0xd1, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7,
+      0xe7, 0xe6, 0xe5, 0xe4, 0xe3, 0xe2, 0xe1, 0xe0, 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+      0xef, 0xee, 0xed, 0xec, 0xeb, 0xea, 0xe9, 0xe8, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff};
+
+  struct PanelMaps
+  {
+    // [rotation][shift register position] -> index into the render buffer
+    uint8_t map[4][ROWS * COLS];
+    // [rotation][index into the render buffer] -> shift register position
+    uint8_t position[4][ROWS * COLS];
+  };
+
+  constexpr void swapIndex(uint8_t *buffer, int a, int b)
+  {
+    uint8_t tmp = buffer[a];
+    buffer[a] = buffer[b];
+    buffer[b] = tmp;
+  }
+
+  // Runs the quarter turns on an identity buffer and folds the result into
+  // the wiring map, so the refresh needs a single lookup per pixel.
+  constexpr PanelMaps buildPanelMaps()
+  {
+    PanelMaps maps{};
+
+    for (int rotation = 0; rotation < 4; rotation++)
+    {
+      uint8_t source[ROWS * COLS] = {};
+      for (int i = 0; i < ROWS * COLS; i++)
+      {
+        source[i] = i;
+      }
+
+      for (int row = 0; row < ROWS / 2; row++)
+      {
+        for (int col = row; col < COLS - row - 1; col++)
+        {
+          for (int r = 0; r < rotation; r++)
+          {
+            swapIndex(source, row * ROWS + col, col * ROWS + (ROWS - 1 - row));
+            swapIndex(source, row * ROWS + col, (ROWS - 1 - row) * ROWS + (ROWS - 1 - col));
+            swapIndex(source, row * ROWS + col, (ROWS - 1 - col) * ROWS + row);
+          }
+        }
+      }
+
+      for (int idx = 0; idx < ROWS * COLS; idx++)
+      {
+        maps.map[rotation][idx] = source[panelPositions[idx]];
+        maps.position[rotation][source[panelPositions[idx]]] = idx;
+      }
+    }
+
+    return maps;
+  }
+
+  // kept in DRAM, the refresh interrupt must not depend on the flash cache
+  DRAM_ATTR constexpr PanelMaps panelMaps = buildPanelMaps();
+
+#ifdef ESP32
+  hw_timer_t *screenTimer = nullptr;
+#endif
+  volatile uint32_t tickIntervalUs = 0;
+
+  // active refresh profile. The base interval is one PWM subframe, or the
+  // least significant plane with ENABLE_BCM_REFRESH. Every gray shift halves
+  // the gray levels and with them the subframes of one refresh.
+#ifdef ENABLE_BCM_REFRESH
+  constexpr Subframes::Mode refreshMode = Subframes::BCM;
+  volatile uint32_t baseIntervalUs = BCM_LSB_US;
+#else
+  constexpr Subframes::Mode refreshMode = Subframes::PWM;
+  volatile uint32_t baseIntervalUs = TIMER_INTERVAL_US;
+#endif
+  volatile uint8_t grayShift = 0;
+  volatile uint8_t activeSubframeCount = SUBFRAMES;
+
+  // SPI frames of one full refresh, built at commit time. The refresh streams
+  // the active set while the next commit encodes into the other one.
+  uint32_t subframeCache[2][SUBFRAMES][SUBFRAME_BYTES / 4];
+  std::atomic<uint32_t *> activeSubframes{&subframeCache[0][0][0]};
+
+  inline bool needsModulation(uint8_t value)
+  {
+    return Subframes::needsModulation(refreshMode, value, grayShift);
+  }
+
+  inline uint32_t refreshPeriods(uint8_t shift)
+  {
+    return Subframes::refreshPeriods(refreshMode, shift);
+  }
+
+  inline void writeSubframePixel(uint8_t *subframes, int position, uint8_t value)
+  {
+    Subframes::writePixel(refreshMode, subframes, position, value, grayShift);
+  }
+
+  void blendRow(uint8_t *target, const uint8_t *source, BlendMode mode, uint8_t opacity)
+  {
+    for (int x = 0; x < COLS; x++)
+    {
+      int below = target[x];
+      int value = source[x];
+      // max and add scale the layer, replace and mask fade the result
+      int fade = opacity;
+      switch (mode)
+      {
+      case BLEND_REPLACE:
+        break;
+      case BLEND_MAX:
+        value = max(below, value * opacity / 255);
+        fade = 255;
+        break;
+      case BLEND_ADD:
+        value = min(below + value * opacity / 255, 255);
+        fade = 255;
+        break;
+      case BLEND_MASK:
+        value = below * value / 255;
+        break;
+      }
+      target[x] = fade == 255 ? value : below + (value - below) * fade / 255;
+    }
+  }
+}
+
+Screen_::Screen_()
+    : front_(frames_[0]),
+      panelMap_(panelMaps.map[0]), panelPosition_(panelMaps.position[0])
+{
+  layerState_[LAYER_BASE].visible = true;
+}
+
 uint8_t Screen_::getCurrentBrightness() const
 {
   return brightness_;
@@ -31,38 +194,415 @@ void Screen_::setBrightness(uint8_t brightness, bool shouldStore)
 #endif
 }
 
+void Screen_::beginFrame()
+{
+  frameDepth_++;
+}
+
+void Screen_::present(bool waitForRefresh)
+{
+  if (frameDepth_ > 0 && --frameDepth_ > 0)
+  {
+    return;
+  }
+
+  // the base layer may have changed anywhere
+  staleRows_ = ALL_ROWS;
+  show();
+
+  if (waitForRefresh)
+  {
+    this->waitForRefresh();
+  }
+}
+
+uint8_t *Screen_::layerPixels(Layer layer)
+{
+  return layer == LAYER_BASE ? back_ : layers_[layer - 1];
+}
+
+bool Screen_::isLayered() const
+{
+  const LayerState &base = layerState_[LAYER_BASE];
+  if (!base.visible || base.mode != BLEND_REPLACE || base.opacity != 255)
+  {
+    return true;
+  }
+  for (int layer = LAYER_BASE + 1; layer < LAYERS; layer++)
+  {
+    if (layerState_[layer].visible)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Screen_::compose(uint16_t rows)
+{
+  for (int row = 0; row < ROWS; row++)
+  {
+    if (!(rows & (1 << row)))
+    {
+      continue;
+    }
+    uint8_t *target = composite_ + row * COLS;
+    memset(target, 0, COLS);
+    for (int layer = LAYER_BASE; layer < LAYERS; layer++)
+    {
+      const LayerState &state = layerState_[layer];
+      if (state.visible && state.opacity > 0)
+      {
+        blendRow(target, layerPixels((Layer)layer) + row * COLS, state.mode, state.opacity);
+      }
+    }
+  }
+}
+
+void Screen_::show()
+{
+  // only the base layer shows its pixels as they are
+  const uint8_t *frame = back_;
+  if (isLayered())
+  {
+    compose(staleRows_);
+    staleRows_ = 0;
+    frame = composite_;
+  }
+  else
+  {
+    staleRows_ = ALL_ROWS;
+  }
+
+  uint8_t *shown = front_.load(std::memory_order_relaxed);
+  uint16_t rows = 0;
+  for (int row = 0; row < ROWS; row++)
+  {
+    if (memcmp(frame + row * COLS, shown + row * COLS, COLS))
+    {
+      rows |= 1 << row;
+    }
+  }
+
+  // an unchanged frame keeps its generation and encoded subframes
+  if (rows)
+  {
+    uint8_t *spare = shown == frames_[0] ? frames_[1] : frames_[0];
+    memcpy(spare, frame, ROWS * COLS);
+    front_.store(spare, std::memory_order_release);
+    markDirty(rows);
+    commit(rows);
+  }
+}
+
+void Screen_::present(const Canvas &canvas, bool waitForRefresh)
+{
+  beginFrame();
+  memcpy(back_, canvas.pixels, ROWS * COLS);
+  present(waitForRefresh);
+}
+
+void Screen_::waitForRefresh()
+{
+  uint32_t start = refreshCount_;
+  while (refreshCount_ == start)
+  {
+    delay(1);
+  }
+}
+
+void Screen_::setLayer(Layer layer, const uint8_t *pixels, BlendMode mode, uint8_t opacity)
+{
+  uint8_t *target = layerPixels(layer);
+  LayerState &state = layerState_[layer];
+  if (!state.visible || state.mode != mode || state.opacity != opacity)
+  {
+    staleRows_ = ALL_ROWS;
+  }
+  else
+  {
+    for (int row = 0; row < ROWS; row++)
+    {
+      if (memcmp(target + row * COLS, pixels + row * COLS, COLS))
+      {
+        staleRows_ |= 1 << row;
+      }
+    }
+  }
+  memcpy(target, pixels, ROWS * COLS);
+  state.mode = mode;
+  state.opacity = opacity;
+  state.visible = true;
+
+  if (frameDepth_ == 0)
+  {
+    show();
+  }
+}
+
+void Screen_::setLayer(Layer layer, const Canvas &canvas, BlendMode mode, uint8_t opacity)
+{
+  setLayer(layer, canvas.pixels, mode, opacity);
+}
+
+void Screen_::setLayerBlend(Layer layer, BlendMode mode, uint8_t opacity)
+{
+  LayerState &state = layerState_[layer];
+  if (state.mode != mode || state.opacity != opacity)
+  {
+    state.mode = mode;
+    state.opacity = opacity;
+    staleRows_ = ALL_ROWS;
+    if (frameDepth_ == 0)
+    {
+      show();
+    }
+  }
+}
+
+void Screen_::hideLayer(Layer layer)
+{
+  if (layerState_[layer].visible)
+  {
+    layerState_[layer].visible = false;
+    staleRows_ = ALL_ROWS;
+    if (frameDepth_ == 0)
+    {
+      show();
+    }
+  }
+}
+
+bool Screen_::isLayerVisible(Layer layer) const
+{
+  return layerState_[layer].visible;
+}
+
+void Screen_::commit(uint16_t rows)
+{
+  uint32_t *active = activeSubframes.load(std::memory_order_relaxed);
+  uint32_t *spare = active == &subframeCache[0][0][0] ? &subframeCache[1][0][0] : &subframeCache[0][0][0];
+  const uint8_t *frame = front_.load(std::memory_order_relaxed);
+
+  // the spare set still lacks whatever went into the active one last time
+  uint16_t encode = rows | spareStaleRows_;
+  if (encode == ALL_ROWS)
+  {
+    memset(spare, 0, sizeof(subframeCache[0]));
+    for (int position = 0; position < ROWS * COLS; position++)
+    {
+      writeSubframePixel((uint8_t *)spare, position, frame[panelMap_[position]]);
+    }
+  }
+  else
+  {
+    for (int row = 0; row < ROWS; row++)
+    {
+      if (!(encode & (1 << row)))
+      {
+        continue;
+      }
+      for (int index = row * COLS; index < (row + 1) * COLS; index++)
+      {
+        writeSubframePixel((uint8_t *)spare, panelPosition_[index], frame[index]);
+      }
+    }
+  }
+  activeSubframes.store(spare, std::memory_order_release);
+  spareStaleRows_ = rows;
+
+  uint16_t modulated = 0;
+  for (int index = 0; index < ROWS * COLS; index++)
+  {
+    modulated += needsModulation(frame[index]);
+  }
+  setModulatedPixels(modulated);
+#ifdef ENABLE_REFRESH_METRICS
+  metrics_.framesCommitted++;
+#endif
+
+  unsigned long now = millis();
+  commitCount_++;
+  if (now - commitWindowStart_ >= 1000)
+  {
+    commitsPerSecond_ = commitCount_ * 1000 / (now - commitWindowStart_);
+    commitCount_ = 0;
+    commitWindowStart_ = now;
+  }
+}
+
+uint32_t Screen_::getCommitsPerSecond() const
+{
+  // no commit for a while, the last window is stale
+  return millis() - commitWindowStart_ > 2000 ? 0 : commitsPerSecond_;
+}
+
+uint32_t Screen_::getIsrCycles() const
+{
+  return isrCycles_;
+}
+
+void Screen_::markDirty(uint16_t rows)
+{
+  generation_++;
+  dirtyHistory_[generation_ % DIRTY_HISTORY] = rows;
+}
+
+uint32_t Screen_::getGeneration() const
+{
+  return generation_;
+}
+
+uint16_t Screen_::getDirtyRows(uint32_t sinceGeneration) const
+{
+  uint32_t age = generation_ - sinceGeneration;
+  if (age > DIRTY_HISTORY)
+  {
+    return ALL_ROWS;
+  }
+
+  uint16_t rows = 0;
+  for (uint32_t generation = sinceGeneration + 1; age > 0; generation++, age--)
+  {
+    rows |= dirtyHistory_[generation % DIRTY_HISTORY];
+  }
+  return rows;
+}
+
+bool Screen_::isIdle() const
+{
+  return modulatedPixels_ == 0;
+}
+
+const RefreshProfile &Screen_::getRefreshProfile() const
+{
+  return refreshProfile_;
+}
+
+void Screen_::tuneRefresh()
+{
+  tunePeakCycles_ = 0;
+  tuneSpiCycles_ = 0;
+  tuneSamples_ = TUNE_SAMPLES;
+  tunePending_ = true;
+  wakeRefresh();
+}
+
+void Screen_::updateRefreshProfile()
+{
+  if (!tunePending_ || tuneSamples_ > 0)
+  {
+    return;
+  }
+  tunePending_ = false;
+
+  uint32_t cyclesPerUs = ESP.getCpuFreqMHz();
+  uint32_t renderUs = (tunePeakCycles_ + cyclesPerUs - 1) / cyclesPerUs;
+  uint32_t spiUs = (tuneSpiCycles_ + cyclesPerUs - 1) / cyclesPerUs;
+
+  // shortest base interval that keeps the worst tick inside the budget,
+  // the binary weighted planes only get longer than that
+  uint32_t intervalUs = renderUs * 100 / REFRESH_ISR_BUDGET_PERCENT;
+  intervalUs = std::max<uint32_t>(REFRESH_MIN_INTERVAL_US, (intervalUs + 9) / 10 * 10);
+
+  // then as many gray levels as the minimum refresh rate allows
+  uint8_t shift = 0;
+  while (shift < MAX_GRAY_SHIFT && 1000000 / (intervalUs * refreshPeriods(shift)) < REFRESH_MIN_HZ)
+  {
+    shift++;
+  }
+
+  baseIntervalUs = intervalUs;
+  grayShift = shift;
+  activeSubframeCount = Subframes::count(refreshMode, shift);
+
+  refreshProfile_.intervalUs = intervalUs;
+  refreshProfile_.grayLevels = GRAY_LEVELS >> shift;
+  refreshProfile_.refreshHz = 1000000 / (intervalUs * refreshPeriods(shift));
+  refreshProfile_.renderUs = renderUs;
+  refreshProfile_.spiUs = spiUs;
+  refreshProfile_.isrLoadPercent = renderUs * 100 / intervalUs;
+
+  // the subframe layout changed, both sets need a full encode
+  spareStaleRows_ = ALL_ROWS;
+  commit(ALL_ROWS);
+  wakeRefresh();
+}
+
+void Screen_::setModulatedPixels(uint16_t count)
+{
+  modulatedPixels_ = count;
+
+  // the keep-alive rate would delay the change, latch it right away
+  if (tickIntervalUs == IDLE_REFRESH_US)
+  {
+    wakeRefresh();
+  }
+}
+
+void Screen_::writePixel(int index, uint8_t value)
+{
+  back_[index] = value;
+  if (frameDepth_ == 0 && isLayered())
+  {
+    staleRows_ |= 1 << (index / COLS);
+    show();
+  }
+  else if (frameDepth_ == 0)
+  {
+    // single pixel, patch the streamed subframes instead of a full commit
+    uint8_t *front = front_.load(std::memory_order_relaxed);
+    if (front[index] == value)
+    {
+      return;
+    }
+    uint16_t row = 1 << (index / COLS);
+    markDirty(row);
+    spareStaleRows_ |= row;
+    uint16_t modulated = modulatedPixels_ - needsModulation(front[index]) + needsModulation(value);
+    front[index] = value;
+    writeSubframePixel((uint8_t *)activeSubframes.load(std::memory_order_relaxed), panelPosition_[index], value);
+    setModulatedPixels(modulated);
+  }
+}
+
 void Screen_::setRenderBuffer(const uint8_t *renderBuffer, bool grays)
 {
-  updating_ = true;
+  beginFrame();
   if (grays)
   {
-    memcpy(renderBuffer_, renderBuffer, ROWS * COLS);
+    memcpy(back_, renderBuffer, ROWS * COLS);
   }
   else
   {
     for (int i = 0; i < ROWS * COLS; i++)
     {
-      renderBuffer_[i] = renderBuffer[i] * 255;
+      back_[i] = renderBuffer[i] * 255;
     }
   }
-  updating_ = false;
+  present();
 }
 
 uint8_t *Screen_::getRenderBuffer()
 {
-  return renderBuffer_;
+  return back_;
+}
+
+const uint8_t *Screen_::getShownFrame() const
+{
+  return front_.load(std::memory_order_acquire);
 }
 
 uint8_t Screen_::getBufferIndex(int index)
 {
-  return renderBuffer_[index];
+  return back_[index];
 }
 
 void Screen_::clear()
 {
-  beginUpdate();
-  memset(renderBuffer_, 0, ROWS * COLS);
-  endUpdate();
+  beginFrame();
+  memset(back_, 0, ROWS * COLS);
+  present();
 }
 
 void Screen_::clearRect(int x, int y, int width, int height)
@@ -84,12 +624,13 @@ void Screen_::clearRect(int x, int y, int width, int height)
   }
 
   width = std::min(width, COLS - x);
-  beginUpdate();
+  height = std::min(height, ROWS - y);
+  beginFrame();
   for (int row = y; row < y + height; row++)
   {
-    memset(renderBuffer_ + (row * COLS + x), 0, width);
+    memset(back_ + (row * COLS + x), 0, width);
   }
-  endUpdate();
+  present();
 }
 
 // CACHE START
@@ -105,7 +646,7 @@ bool Screen_::isCacheEmpty() const
 
 void Screen_::cacheCurrent()
 {
-  memcpy(cache_, renderBuffer_, ROWS * COLS);
+  memcpy(cache_, back_, ROWS * COLS);
 }
 
 void Screen_::restoreCache()
@@ -123,8 +664,11 @@ void Screen_::loadFromStorage()
 
   if (currentStatus == NONE)
   {
-    clear();
-    storage.getBytes("data", renderBuffer_, ROWS * COLS);
+    beginFrame();
+    memset(back_, 0, ROWS * COLS);
+    storage.getBytes("data", back_, ROWS * COLS);
+    present();
+    persistedGeneration_ = generation_;
   }
   else
   {
@@ -141,7 +685,12 @@ void Screen_::persist()
 {
 #ifdef ENABLE_STORAGE
   storage.begin("led-wall");
-  storage.putBytes("data", renderBuffer_, ROWS * COLS);
+  // spare the flash if the frame is the one already stored
+  if (persistedGeneration_ != generation_ || frameDepth_ > 0)
+  {
+    storage.putBytes("data", back_, ROWS * COLS);
+    persistedGeneration_ = generation_;
+  }
   storage.putUInt("brightness", brightness_);
   storage.putUInt("rotation", currentRotation);
   storage.end();
@@ -169,40 +718,42 @@ void Screen_::setup()
 
   timer1_attachInterrupt(&onScreenTimer);
   timer1_enable(TIM_DIV256, TIM_EDGE, TIM_SINGLE);
-  timer1_write(100);
+  scheduleNextTick(baseIntervalUs);
 #endif
 
 #ifdef ESP32
   SPI.begin(PIN_CLOCK, 34, PIN_DATA, 25); // SCLK, MISO, MOSI, SS
   SPI.beginTransaction(SPISettings(10000000, MSBFIRST, SPI_MODE0));
 
-  hw_timer_t *Screen_timer = timerBegin(1000000);
-  timerAttachInterrupt(Screen_timer, &onScreenTimer);
-  timerAlarm(Screen_timer, TIMER_INTERVAL_US, true, 0);
+  screenTimer = timerBegin(1000000);
+  timerAttachInterrupt(screenTimer, &onScreenTimer);
+  scheduleNextTick(baseIntervalUs);
 #endif
+
+  // measure the refresh on this board, the drawing task applies the result
+  tuneRefresh();
 }
 
 void Screen_::setPixelAtIndex(uint8_t index, uint8_t value, uint8_t brightness)
 {
   if (index >= COLS * ROWS)
     return;
-  updating_ = true;
-  renderBuffer_[index] = value <= 0 || brightness <= 0 ? 0 : (brightness > 255 ? 255 : brightness);
-  updating_ = false;
+  writePixel(index, value <= 0 || brightness <= 0 ? 0 : brightness);
 }
 
 void Screen_::setPixel(uint8_t x, uint8_t y, uint8_t value, uint8_t brightness)
 {
   if (x >= COLS || y >= ROWS)
     return;
-  updating_ = true;
-  renderBuffer_[y * COLS + x] = value <= 0 || brightness <= 0 ? 0 : (brightness > 255 ? 255 : brightness);
-  updating_ = false;
+  writePixel(y * COLS + x, value <= 0 || brightness <= 0 ? 0 : brightness);
 }
 
 void Screen_::setCurrentRotation(int rotation, bool shouldPersist)
 {
   currentRotation = rotation & 0x3;
+  panelMap_ = panelMaps.map[currentRotation];
+  panelPosition_ = panelMaps.position[currentRotation];
+  commit(ALL_ROWS);
 
 #ifdef ENABLE_STORAGE
   if (shouldPersist)
@@ -214,69 +765,174 @@ void Screen_::setCurrentRotation(int rotation, bool shouldPersist)
 #endif
 }
 
-uint8_t *Screen_::getRotatedRenderBuffer()
+void Screen_::onScreenTimer()
 {
-  for (int i = 0; i < ROWS * COLS; i++)
-  {
-    rotatedRenderBuffer_[i] = renderBuffer_[i];
-  }
+  Screen._render();
+}
 
-  rotate();
+void Screen_::scheduleNextTick(uint32_t intervalUs)
+{
+  tickIntervalUs = intervalUs;
+#ifdef ESP8266
+  // timer1 runs at 80MHz / 256 = 3.2us per tick
+  timer1_write(intervalUs * 5 / 16);
+#endif
+#ifdef ESP32
+  timerAlarm(screenTimer, intervalUs, true, 0);
+#endif
+}
 
-  return rotatedRenderBuffer_;
+void Screen_::wakeRefresh()
+{
+#ifdef ESP32
+  if (!screenTimer)
+  {
+    return;
+  }
+  timerWrite(screenTimer, 0);
+#endif
+  scheduleNextTick(baseIntervalUs);
 }
 
-void Screen_::rotate()
+ICACHE_RAM_ATTR void Screen_::_render()
 {
-  for (int row = 0; row < ROWS / 2; row++)
+  static uint8_t subframe = 0;
+  uint32_t start = ESP.getCycleCount();
+#ifdef ENABLE_REFRESH_METRICS
+  uint32_t expectedUs = tickIntervalUs;
+#endif
+  // without gray pixels all subframes are equal, latching one is enough
+  bool idle = modulatedPixels_ == 0 && tuneSamples_ == 0;
+  if (idle || subframe >= activeSubframeCount)
+  {
+    subframe = 0;
+  }
+  const uint32_t *bits = activeSubframes.load(std::memory_order_acquire) + subframe * (SUBFRAME_BYTES / 4);
+
+  digitalWrite(PIN_LATCH, LOW);
+  uint32_t spiStart = ESP.getCycleCount();
+  SPI.writeBytes((const uint8_t *)bits, SUBFRAME_BYTES);
+  uint32_t spiCycles = ESP.getCycleCount() - spiStart;
+  digitalWrite(PIN_LATCH, HIGH);
+
+  uint32_t nextIntervalUs;
+  if (idle)
   {
-    for (int col = row; col < COLS - row - 1; col++)
+    nextIntervalUs = IDLE_REFRESH_US;
+    refreshCount_ = refreshCount_ + 1;
+  }
+  else
+  {
+    nextIntervalUs = Subframes::intervalUs(refreshMode, baseIntervalUs, subframe);
+    if (++subframe >= activeSubframeCount)
     {
-      for (int r = 0; r < currentRotation; r++)
-      {
-        swap(rotatedRenderBuffer_[row * ROWS + col], rotatedRenderBuffer_[col * ROWS + (ROWS - 1 - row)]);
-        swap(rotatedRenderBuffer_[row * ROWS + col], rotatedRenderBuffer_[(ROWS - 1 - row) * ROWS + (ROWS - 1 - col)]);
-        swap(rotatedRenderBuffer_[row * ROWS + col], rotatedRenderBuffer_[(ROWS - 1 - col) * ROWS + row]);
-      }
+      subframe = 0;
+      refreshCount_ = refreshCount_ + 1;
     }
   }
-}
 
-void Screen_::onScreenTimer()
-{
-  Screen._render();
+#ifndef ESP8266
+  // the esp32 alarm reloads by itself, only touch it if the period changes
+  if (nextIntervalUs != tickIntervalUs)
+#endif
+  {
+    scheduleNextTick(nextIntervalUs);
+  }
+  isrCycles_ = ESP.getCycleCount() - start;
+
+#ifdef ENABLE_REFRESH_METRICS
+  recordTick(isrCycles_, spiCycles, expectedUs);
+#endif
+
+  if (tuneSamples_ > 0)
+  {
+    uint32_t cycles = isrCycles_;
+    if (cycles > tunePeakCycles_)
+    {
+      tunePeakCycles_ = cycles;
+    }
+    if (spiCycles > tuneSpiCycles_)
+    {
+      tuneSpiCycles_ = spiCycles;
+    }
+    tuneSamples_ = tuneSamples_ - 1;
+  }
 }
 
-ICACHE_RAM_ATTR void Screen_::_render()
+#ifdef ENABLE_REFRESH_METRICS
+ICACHE_RAM_ATTR void Screen_::recordTick(uint32_t cycles, uint32_t spiCycles, uint32_t expectedUs)
 {
-  if (updating_) {
-    // skip this frame to avoid tearing of partial digits
-    return;
+  uint32_t now = micros();
+  TickMetrics &m = metrics_;
+
+  // a tick arriving more than half an interval late means the ones in
+  // between were lost, e.g. to interrupts being disabled
+  if (m.lastTickUs && expectedUs)
+  {
+    uint32_t gapUs = now - m.lastTickUs;
+    if (gapUs > expectedUs + expectedUs / 2)
+    {
+      m.skippedTicks += gapUs / expectedUs - 1;
+    }
   }
-  const auto buf = getRotatedRenderBuffer();
+  m.lastTickUs = now;
 
-  // SPI data needs to be 32-bit aligned, round up before divide
-  static unsigned long spi_bits[(ROWS * COLS + 8 * sizeof(unsigned long) - 1) / 8 / sizeof(unsigned long)] = {0};
-  unsigned char *bits = (unsigned char *)spi_bits;
-  memset(bits, 0, ROWS * COLS / 8);
+  m.ticks++;
+  m.cycleSum += cycles;
+  m.spiCycleSum += spiCycles;
+  m.minCycles = std::min(m.minCycles, cycles);
+  m.maxCycles = std::max(m.maxCycles, cycles);
+  m.histogram[std::min<uint32_t>(cycles / METRICS_BUCKET_CYCLES, METRICS_BUCKETS - 1)]++;
 
-  static unsigned char counter = 0;
+  if (refreshCount_ != m.windowRefreshes && now - m.windowStartUs >= 1000000)
+  {
+    m.refreshHz = (uint64_t)(refreshCount_ - m.windowRefreshes) * 1000000 / (now - m.windowStartUs);
+    m.windowRefreshes = refreshCount_;
+    m.windowStartUs = now;
+  }
+}
 
-  for (int idx = 0; idx < ROWS * COLS; idx++)
+RefreshMetrics Screen_::getRefreshMetrics() const
+{
+  // plain copy, a tick landing in between only skews one sample
+  TickMetrics m = metrics_;
+  RefreshMetrics result;
+
+  result.ticks = m.ticks;
+  result.skippedTicks = m.skippedTicks;
+  result.framesCommitted = m.framesCommitted;
+  result.refreshHz = micros() - m.windowStartUs > 2000000 ? 0 : m.refreshHz;
+  if (m.ticks == 0)
   {
-    bits[idx >> 3] |= (buf[positions[idx]] > counter ? 0x80 : 0) >> (idx & 7);
+    return result;
   }
 
-  counter += (256 / GRAY_LEVELS);
+  result.minCycles = m.minCycles;
+  result.maxCycles = m.maxCycles;
+  result.avgCycles = m.cycleSum / m.ticks;
+  result.avgSpiCycles = m.spiCycleSum / m.ticks;
 
-  digitalWrite(PIN_LATCH, LOW);
-  SPI.writeBytes(bits, sizeof(spi_bits));
-  digitalWrite(PIN_LATCH, HIGH);
-#ifdef ESP8266
-  timer1_write(100);
-#endif
+  // upper edge of the bucket holding the 99th percentile
+  uint32_t rank = m.ticks - m.ticks / 100;
+  uint32_t seen = 0;
+  for (int bucket = 0; bucket < METRICS_BUCKETS; bucket++)
+  {
+    seen += m.histogram[bucket];
+    if (seen >= rank)
+    {
+      result.p99Cycles = std::min(m.maxCycles, (uint32_t)(bucket + 1) * METRICS_BUCKET_CYCLES);
+      break;
+    }
+  }
+  return result;
 }
 
+void Screen_::resetRefreshMetrics()
+{
+  metrics_ = TickMetrics();
+}
+#endif
+
 void Screen_::drawLine(int x1, int y1, int x2, int y2, int ledStatus, uint8_t brightness)
 {
   int dx = abs(x2 - x1);
@@ -324,90 +980,56 @@ void Screen_::drawRectangle(int x, int y, int width, int height, bool fill, int
   }
 };
 
-void Screen_::drawCharacter(int x, int y, std::vector<int> bits, int bitCount, uint8_t brightness)
+void Screen_::drawGlyph(int x, int y, const Glyph &glyph, uint8_t brightness)
 {
-  for (int i = 0; i < bits.size(); i += bitCount)
-  {
-    for (int j = 0; j < bitCount; j++)
-    {
-      setPixel(x + j, (y + (i / bitCount)), bits[i + j], brightness);
-    }
-  }
+  beginFrame();
+  blitGlyph(back_, x, y, glyph.bits, glyph.width, glyph.height, brightness, false);
+  present();
 }
 
-std::vector<int> Screen_::readBytes(std::vector<int> bytes)
-{
-  vector<int> bits;
-  int k = 0;
-
-  for (int i = 0; i < bytes.size(); i++)
-  {
-    for (int j = 8 - 1; j >= 0; j--)
-    {
-      int b = (bytes[i] >> j) & 1;
-      bits.push_back(b);
-      k++;
-    }
-  }
-
-  return bits;
-};
-
-void Screen_::drawNumbers(int x, int y, std::vector<int> numbers, uint8_t brightness)
+void Screen_::drawNumbers(int x, int y, std::initializer_list<int> numbers, uint8_t brightness)
 {
-  for (int i = 0; i < numbers.size(); i++)
+  beginFrame();
+  for (int number : numbers)
   {
-    drawCharacter(x + (i * 5), y, readBytes(smallNumbers[numbers.at(i)]), 4, brightness);
+    drawGlyph(x, y, smallNumber(number), brightness);
+    x += 5;
   }
+  present();
 }
 
-void Screen_::drawBigNumbers(int x, int y, std::vector<int> numbers, uint8_t brightness)
+void Screen_::drawBigNumbers(int x, int y, std::initializer_list<int> numbers, uint8_t brightness)
 {
-  for (int i = 0; i < numbers.size(); i++)
+  beginFrame();
+  for (int number : numbers)
   {
-    drawCharacter(x + (i * 8), y, readBytes(bigNumbers[numbers.at(i)]), 8, brightness);
+    drawGlyph(x, y, bigNumber(number), brightness);
+    x += 8;
   }
+  present();
 }
 
 void Screen_::drawWeather(int x, int y, int weather, uint8_t brightness)
 {
-  drawCharacter(x, y, readBytes(weatherIcons[weather]), 16, brightness);
+  drawGlyph(x, y, weatherIcon(weather), brightness);
 }
 
-void Screen_::scrollText(std::string text, int delayTime, uint8_t brightness, uint8_t fontid)
+void Screen_::scrollText(const std::string &text, int delayTime, uint8_t brightness, uint8_t fontid)
 {
-  // lets determine the current font
-  font currentFont = (fontid < fonts.size()) ? fonts[fontid] : fonts[0];
-
-  int textWidth = text.length() * (currentFont.sizeX + 1); // charsize + space
-
-  for (int i = -ROWS; i < textWidth; i++)
-  { // start with negative screen size, so out of screen to the right
-
-    int skippedChars = 0;
-
-    clear();
-
-    for (std::size_t strPos = 0; strPos < text.length(); strPos++)
-    { // since i need the pos to calculate, this is the best way to iterate here
-      if (text[strPos] == 195)
-      {
-        // we skip the unicode char indicating special characters
-        skippedChars++;
-      }
-      else
-      {
-        int xPos = (strPos - skippedChars) * (currentFont.sizeX + 1) - i;
-
-        if (xPos > -6 && xPos < ROWS)
-        { // so are we somewhere on screen with the char?
-          // ensure that we have a defined char, lets take the first
-          uint8_t currentChar = (((text[strPos] - currentFont.offset) < currentFont.data.size()) && (text[strPos] >= currentFont.offset)) ? text[strPos] : currentFont.offset;
+  // a repeated text reuses the strip rendered last time
+  textStrip_.render(text, fontid);
+  scrollText(textStrip_, delayTime, brightness);
+}
 
-          Screen.drawCharacter(xPos, 4, Screen.readBytes(currentFont.data[currentChar - currentFont.offset]), 8);
-        }
-      }
-    }
+void Screen_::scrollText(const TextStrip &strip, int delayTime, uint8_t brightness)
+{
+  // start with negative screen size, so out of screen to the right
+  for (int i = -COLS; i < strip.width(); i++)
+  {
+    beginFrame();
+    memset(back_, 0, ROWS * COLS);
+    strip.drawWindow(back_, i, 4, brightness);
+    present();
 
     delay(delayTime);
   }
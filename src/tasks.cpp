@@ -0,0 +1,36 @@
+#include "tasks.h"
+
+#if defined(ESP32) || defined(HOST_TASKS)
+Tasks_ &Tasks_::getInstance()
+{
+  static Tasks_ instance;
+  return instance;
+}
+
+TaskHandle_t Tasks_::spawn(TaskFunction_t function, const char *name, uint32_t stack, UBaseType_t priority, int8_t core, const TaskLoad *load)
+{
+  TaskHandle_t handle = nullptr;
+  xTaskCreatePinnedToCore(function, name, stack, nullptr, priority, &handle, core);
+  add(name, core, handle, load);
+  return handle;
+}
+
+void Tasks_::add(const char *name, int8_t core, TaskHandle_t handle, const TaskLoad *load)
+{
+  tasks.push_back({name, core, handle, load});
+}
+
+std::vector<TaskEntry> &Tasks_::getAll()
+{
+  for (TaskEntry &task : tasks)
+  {
+    if (!task.handle)
+    {
+      task.handle = xTaskGetHandle(task.name);
+    }
+  }
+  return tasks;
+}
+
+Tasks_ &Tasks = Tasks.getInstance();
+#endif
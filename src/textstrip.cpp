@@ -0,0 +1,72 @@
+#include "textstrip.h"
+
+void TextStrip::render(const std::string &text, uint8_t fontId)
+{
+  if (rendered_ && fontId == fontId_ && text == text_)
+  {
+    return;
+  }
+
+  const Font &font = getFont(fontId);
+  int advance = font.sizeX + 1; // charsize + space
+
+  // we skip the unicode char indicating special characters
+  int characters = 0;
+  for (char character : text)
+  {
+    characters += (uint8_t)character != 195;
+  }
+
+  columns_.assign(characters * advance, 0);
+  int x = 0;
+  for (char character : text)
+  {
+    if ((uint8_t)character == 195)
+    {
+      continue;
+    }
+
+    // undefined chars are drawn as the first one of the font. Glyphs are 8
+    // columns wide and opaque, the next character overwrites the overhang.
+    Glyph glyph = font.glyph(character);
+    for (int col = 0; col < glyph.width && x + col < width(); col++)
+    {
+      uint8_t column = 0;
+      for (int row = 0; row < glyph.height && row < 8; row++)
+      {
+        column |= ((pgm_read_byte(glyph.bits + row) >> (7 - col)) & 1) << row;
+      }
+      columns_[x + col] = column;
+    }
+    x += advance;
+  }
+
+  text_ = text;
+  fontId_ = fontId;
+  height_ = min((int)font.sizeY, 8);
+  rendered_ = true;
+}
+
+void TextStrip::clear()
+{
+  columns_.clear();
+  text_.clear();
+  rendered_ = false;
+}
+
+void TextStrip::drawWindow(uint8_t *pixels, int offset, int y, uint8_t value) const
+{
+  int fromRow = max(0, -y);
+  int toRow = min((int)height_, ROWS - y);
+
+  for (int x = 0; x < COLS; x++)
+  {
+    int index = offset + x;
+    uint8_t column = index >= 0 && index < width() ? columns_[index] : 0;
+    uint8_t *pixel = pixels + (y + fromRow) * COLS + x;
+    for (int row = fromRow; row < toRow; row++, pixel += COLS)
+    {
+      *pixel = (column >> row) & 1 ? value : 0;
+    }
+  }
+}
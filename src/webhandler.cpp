@@ -1,9 +1,24 @@
 #include "webhandler.h"
+#include "commands.h"
+#include "ingest.h"
+#include "tasks.h"
 #include "messages.h"
 #include "scheduler.h"
 #include "websocket.h"
 
-// http://your-server/message?text=Hello&repeat=3&id=42&graph=1,2,3,4
+// the command queue is full, the client may retry
+static void sendBusy(AsyncWebServerRequest *request)
+{
+    StaticJsonDocument<256> jsonResponse;
+    jsonResponse["error"] = true;
+    jsonResponse["errormessage"] = "Busy, try again";
+
+    String output;
+    serializeJson(jsonResponse, output);
+    request->send(503, "application/json", output);
+}
+
+// http://your-server/message?text=Hello&repeat=3&id=42&graph=1,2,3,4&urgent=1
 void handleMessage(AsyncWebServerRequest *request)
 {
     std::string text = request->arg("text").c_str();
@@ -12,6 +27,7 @@ void handleMessage(AsyncWebServerRequest *request)
     int delay = request->arg("delay").toInt();
     int miny = request->arg("miny").toInt();
     int maxy = request->arg("maxy").toInt();
+    bool urgent = request->arg("urgent").toInt() != 0;
 
     if (delay <= 0)
     {
@@ -35,11 +51,23 @@ void handleMessage(AsyncWebServerRequest *request)
         token = strtok(nullptr, ",");
     }
 
-    // Add the message
-    Messages.add(text, repeat, id, delay, graph, miny, maxy);
+    Message *msg = new Message();
+    msg->reset();
+    msg->text = text;
+    msg->repeat = repeat;
+    msg->id = id;
+    msg->delay = delay;
+    msg->graph = graph;
+    msg->miny = miny;
+    msg->maxy = maxy;
 
-    // JSON response
     StaticJsonDocument<256> jsonResponse;
+    if (!Commands.post(CMD_ADD_MESSAGE, urgent, msg))
+    {
+        sendBusy(request);
+        return;
+    }
+
     jsonResponse["status"] = "success";
     jsonResponse["message"] = "Message received";
 
@@ -52,7 +80,11 @@ void handleMessage(AsyncWebServerRequest *request)
 void handleMessageRemove(AsyncWebServerRequest *request)
 {
     int id = request->arg("id").toInt();
-    Messages.remove(id);
+    if (!Commands.post(CMD_REMOVE_MESSAGE, id))
+    {
+        sendBusy(request);
+        return;
+    }
 
     StaticJsonDocument<256> jsonResponse;
     jsonResponse["status"] = "success";
@@ -66,12 +98,23 @@ void handleMessageRemove(AsyncWebServerRequest *request)
 void handleSetPlugin(AsyncWebServerRequest *request)
 {
     int id = request->arg("id").toInt();
-    pluginManager.setActivePluginById(id);
 
     StaticJsonDocument<256> jsonResponse;
 
-    if (pluginManager.getActivePlugin() && pluginManager.getActivePlugin()->getId() == id)
+    // switched by the drawing task, so only check that the plugin exists
+    bool exists = false;
+    for (Plugin *plugin : pluginManager.getAllPlugins())
+    {
+        exists |= plugin->getId() == id;
+    }
+
+    if (exists)
     {
+        if (!Commands.post(CMD_SET_PLUGIN, id))
+        {
+            sendBusy(request);
+            return;
+        }
         jsonResponse["status"] = "success";
         jsonResponse["message"] = "Plugin set successfully";
         String output;
@@ -104,7 +147,11 @@ void handleSetBrightness(AsyncWebServerRequest *request)
         return;
     }
 
-    Screen.setBrightness(value, true);
+    if (!Commands.post(CMD_BRIGHTNESS, value))
+    {
+        sendBusy(request);
+        return;
+    }
 
     jsonResponse["status"] = "success";
     jsonResponse["message"] = "Brightness set successfully";
@@ -114,22 +161,113 @@ void handleSetBrightness(AsyncWebServerRequest *request)
     request->send(200, "application/json", output);
 }
 
+// http://your-server/api/ingest?gamma=2.2&blackLevel=4&luma=bt709
+void handleSetIngest(AsyncWebServerRequest *request)
+{
+    StaticJsonDocument<256> jsonResponse;
+
+    IngestSettings current = Ingest.getSettings();
+    float gamma = request->hasArg("gamma") ? request->arg("gamma").toFloat() : current.gamma;
+    int blackLevel = request->hasArg("blackLevel") ? request->arg("blackLevel").toInt() : current.blackLevel;
+    int luma = current.luma;
+    if (request->hasArg("luma"))
+    {
+        String name = request->arg("luma");
+        luma = name == "average" ? LUMA_AVERAGE : name == "bt601" ? LUMA_BT601 : name == "bt709" ? LUMA_BT709 : -1;
+    }
+
+    if (gamma < 0.1f || gamma > 5.0f || blackLevel < 0 || blackLevel > 255 || luma < 0)
+    {
+        jsonResponse["error"] = true;
+        jsonResponse["errormessage"] = "Invalid ingest settings - gamma 0.1 to 5, blackLevel 0 to 255, luma average, bt601 or bt709.";
+        String output;
+        serializeJson(jsonResponse, output);
+        request->send(422, "application/json", output);
+        return;
+    }
+
+    // tables are rebuilt by the drawing task, the next frame of a stream is
+    // converted with them
+    IngestSettings *settings = new IngestSettings();
+    settings->gamma = gamma;
+    settings->blackLevel = blackLevel;
+    settings->luma = (LumaWeights)luma;
+    if (!Commands.post(CMD_INGEST_SETTINGS, 0, settings))
+    {
+        sendBusy(request);
+        return;
+    }
+
+    jsonResponse["status"] = "success";
+    jsonResponse["message"] = "Ingest settings updated";
+
+    String output;
+    serializeJson(jsonResponse, output);
+    request->send(200, "application/json", output);
+}
+
+// http://your-server/api/refresh/tune
+void handleTuneRefresh(AsyncWebServerRequest *request)
+{
+    // measured by the refresh interrupt, applied by the main loop
+    if (!Commands.post(CMD_TUNE_REFRESH))
+    {
+        sendBusy(request);
+        return;
+    }
+
+    StaticJsonDocument<256> jsonResponse;
+    jsonResponse["status"] = "success";
+    jsonResponse["message"] = "Refresh tuning started";
+
+    String output;
+    serializeJson(jsonResponse, output);
+    request->send(202, "application/json", output);
+}
+
+#ifdef ENABLE_REFRESH_METRICS
+void addRefreshMetrics(JsonObject object)
+{
+    RefreshMetrics metrics = Screen.getRefreshMetrics();
+    object["cpuMHz"] = ESP.getCpuFreqMHz();
+    object["ticks"] = metrics.ticks;
+    object["skippedTicks"] = metrics.skippedTicks;
+    object["framesCommitted"] = metrics.framesCommitted;
+    object["refreshHz"] = metrics.refreshHz;
+
+    JsonObject cycles = object.createNestedObject("isrCycles");
+    cycles["min"] = metrics.minCycles;
+    cycles["avg"] = metrics.avgCycles;
+    cycles["max"] = metrics.maxCycles;
+    cycles["p99"] = metrics.p99Cycles;
+    object["spiCycles"] = metrics.avgSpiCycles;
+}
+
+// http://your-server/api/metrics?reset=1
+void handleGetMetrics(AsyncWebServerRequest *request)
+{
+    StaticJsonDocument<512> jsonDocument;
+    addRefreshMetrics(jsonDocument.to<JsonObject>());
+
+    String output;
+    serializeJson(jsonDocument, output);
+    request->send(200, "application/json", output);
+
+    if (request->arg("reset").toInt())
+    {
+        Screen.resetRefreshMetrics();
+    }
+}
+#endif
+
 void handleGetData(AsyncWebServerRequest *request)
 {
     try
     {
         AsyncResponseStream *response = request->beginResponseStream("application/octet-stream");
 
-        int currentpos_src = 0;
-        for (int row = 0; row < ROWS; row++)
-        {
-            for (int col = 0; col < COLS; col++)
-            {
-                uint8_t b = Screen.getRenderBuffer()[currentpos_src];
-                response->write(&b, 1);
-                currentpos_src += 1;
-            }
-        }
+        // as shown, with streams and messages on top of the plugin
+        response->write(Screen.getShownFrame(), ROWS * COLS);
 
         request->send(response);
     }
@@ -150,10 +288,78 @@ void handleGetInfo(AsyncWebServerRequest *request)
     jsonDocument["rows"] = ROWS;
     jsonDocument["cols"] = COLS;
     jsonDocument["status"] = currentStatus;
-    jsonDocument["plugin"] = pluginManager.getActivePlugin()->getId();
+    // the active plugin may be switching on the drawing task
+    PluginSnapshot snapshot;
+    bool active = pluginManager.getSnapshot(snapshot);
+    jsonDocument["plugin"] = active ? snapshot.id : -1;
     jsonDocument["rotation"] = Screen.currentRotation;
     jsonDocument["brightness"] = Screen.getCurrentBrightness();
     jsonDocument["scheduleActive"] = Scheduler.isActive;
+    jsonDocument["commitsPerSecond"] = Screen.getCommitsPerSecond();
+    jsonDocument["isrCycles"] = Screen.getIsrCycles();
+    jsonDocument["refreshIdle"] = Screen.isIdle();
+
+    const RefreshProfile &profile = Screen.getRefreshProfile();
+    JsonObject refresh = jsonDocument.createNestedObject("refresh");
+    refresh["intervalUs"] = profile.intervalUs;
+    refresh["grayLevels"] = profile.grayLevels;
+    refresh["refreshHz"] = profile.refreshHz;
+    refresh["renderUs"] = profile.renderUs;
+    refresh["spiUs"] = profile.spiUs;
+    refresh["isrLoad"] = profile.isrLoadPercent;
+
+    if (active)
+    {
+        JsonObject frames = jsonDocument.createNestedObject("frames");
+        frames["periodMs"] = snapshot.periodMs;
+        frames["count"] = snapshot.frameStats.frames;
+        frames["deadlineMisses"] = snapshot.frameStats.deadlineMisses;
+        frames["maxLateUs"] = snapshot.frameStats.maxLateUs;
+        frames["avgLateUs"] = snapshot.frameStats.avgLateUs;
+        frames["budgetUs"] = snapshot.budgetUs;
+        frames["overruns"] = snapshot.frameStats.overruns;
+        frames["maxTickUs"] = snapshot.frameStats.maxTickUs;
+        frames["avgTickUs"] = snapshot.frameStats.avgTickUs;
+        frames["demotions"] = snapshot.frameStats.demotions;
+        // copied into the document, snapshot is gone before it is sent
+        jsonDocument["pluginStats"] = serialized(std::string(snapshot.stats));
+    }
+
+    JsonObject ingest = jsonDocument.createNestedObject("ingest");
+    IngestSettings settings = Ingest.getSettings();
+    ingest["gamma"] = settings.gamma;
+    ingest["blackLevel"] = settings.blackLevel;
+    ingest["luma"] = settings.luma;
+    ingest["frames"] = Ingest.stats.frames;
+    ingest["duplicates"] = Ingest.stats.duplicates;
+    ingest["collisions"] = Ingest.stats.collisions;
+    ingest["shown"] = Ingest.stats.shown;
+    ingest["stale"] = Ingest.stats.stale;
+    ingest["lastAgeUs"] = Ingest.stats.lastAgeUs;
+    ingest["maxAgeUs"] = Ingest.stats.maxAgeUs;
+    ingest["avgAgeUs"] = Ingest.stats.avgAgeUs;
+    ingest["maxConvertUs"] = Ingest.stats.maxConvertUs;
+    ingest["avgConvertUs"] = Ingest.stats.avgConvertUs;
+
+#ifdef ESP32
+    JsonArray tasks = jsonDocument.createNestedArray("tasks");
+    for (const TaskEntry &entry : Tasks.getAll())
+    {
+        if (!entry.handle)
+        {
+            continue;
+        }
+        JsonObject task = tasks.createNestedObject();
+        task["name"] = entry.name;
+        task["core"] = entry.core;
+        task["priority"] = uxTaskPriorityGet(entry.handle);
+        task["stackFree"] = uxTaskGetStackHighWaterMark(entry.handle);
+        if (entry.load)
+        {
+            task["cpuPermille"] = entry.load->permille;
+        }
+    }
+#endif
 
     // Build metadata
 #ifdef BUILD_TIME_STR
@@ -204,6 +410,7 @@ void handleGetInfo(AsyncWebServerRequest *request)
         JsonObject object = plugins.createNestedObject();
         object["id"] = plugin->getId();
         object["name"] = plugin->getName();
+        object["overruns"] = plugin->overruns;
     }
 
     String output;
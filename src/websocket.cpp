@@ -1,6 +1,9 @@
 #include "PluginManager.h"
+#include "commands.h"
+#include "ingest.h"
 #include "scheduler.h"
 #include "plugins/AnimationPlugin.h"
+#include "webhandler.h"
 
 #ifdef ENABLE_SERVER
 
@@ -9,6 +12,8 @@
 AsyncWebSocket ws("/ws");
 static const char* kApiToken = API_TOKEN;
 static std::set<uint32_t> wsAuthed; // client ids with auth
+static bool dataSent = false;        // clients have the screen of sentGeneration
+static uint32_t sentGeneration = 0;
 
 void sendInfo()
 {
@@ -29,20 +34,24 @@ void sendInfo()
   lastSent = now;
 
   DynamicJsonDocument jsonDocument(8192);
-  if (currentStatus == NONE)
+  // the screen is the bulk of the message, leave it out if nothing changed.
+  // The generation is taken first, a frame shown while copying goes out
+  // with the next message.
+  if (currentStatus == NONE && (!dataSent || Screen.getDirtyRows(sentGeneration)))
   {
+    sentGeneration = Screen.getGeneration();
+    const uint8_t *frame = Screen.getShownFrame();
     for (int j = 0; j < ROWS * COLS; j++)
     {
-      jsonDocument["data"][j] = Screen.getRenderBuffer()[j];
+      jsonDocument["data"][j] = frame[j];
     }
+    dataSent = true;
   }
 
   jsonDocument["status"] = currentStatus;
-  if (pluginManager.getActivePlugin()) {
-    jsonDocument["plugin"] = pluginManager.getActivePlugin()->getId();
-  } else {
-    jsonDocument["plugin"] = -1;
-  }
+  // sent from the network task as well, while a plugin may be switching
+  PluginSnapshot snapshot;
+  jsonDocument["plugin"] = pluginManager.getSnapshot(snapshot) ? snapshot.id : -1;
   jsonDocument["event"] = "info";
   jsonDocument["rotation"] = Screen.currentRotation;
   jsonDocument["brightness"] = Screen.getCurrentBrightness();
@@ -114,6 +123,33 @@ void sendInfo()
   jsonDocument.clear();
 }
 
+void sendAnimationFrames(uint32_t clientId)
+{
+  // Minimal fetch: return current frames from Animation plugin as 32-byte arrays,
+  // no frames for any other plugin
+  DynamicJsonDocument resp(4096);
+  resp["event"] = "animation-frames";
+  JsonArray dataArr = resp.createNestedArray("data");
+  int screens = 0;
+  Plugin *p = pluginManager.getActivePlugin();
+  if (p && strcmp(p->getName(), "Animation") == 0) {
+    const auto &frames = static_cast<AnimationPlugin *>(p)->getFrames();
+    screens = (int)frames.size();
+    for (const auto &f : frames) {
+      JsonArray row = dataArr.createNestedArray();
+      for (int k = 0; k < (int)f.size(); ++k) {
+        row.add(f[k]);
+      }
+    }
+  }
+  resp["screens"] = screens;
+  String out;
+  serializeJson(resp, out);
+  if (ws.availableForWrite(clientId)) {
+    ws.text(clientId, out);
+  }
+}
+
 void onWsEvent(
     AsyncWebSocket *server,
     AsyncWebSocketClient *client,
@@ -124,6 +160,8 @@ void onWsEvent(
 {
   if (type == WS_EVT_CONNECT)
   {
+    // a new client has no screen yet
+    dataSent = false;
     // Simple token check via query string: ws://host/ws?token=...
     if (kApiToken && strlen(kApiToken) > 0) {
       // AsyncWebSocket unfortunately doesn't expose URL here; require an initial auth message instead
@@ -145,11 +183,12 @@ void onWsEvent(
       if (info->opcode == WS_BINARY && currentStatus == WSBINARY && info->len == 256)
       {
         if (kApiToken && strlen(kApiToken) > 0 && wsAuthed.find(client->id()) == wsAuthed.end()) return;
-        Screen.setRenderBuffer(data, true);
+        Ingest.submit(INGEST_GRAY8, data, len);
       }
       else if (info->opcode == WS_TEXT)
       {
-        DynamicJsonDocument wsRequest(1024);
+        // parsed on the stack, only plugin events get a copy on the heap
+        StaticJsonDocument<1024> wsRequest;
         DeserializationError error = deserializeJson(wsRequest, (const char *)data, len);
 
         if (error)
@@ -170,69 +209,61 @@ void onWsEvent(
           return; // don't process further for auth frame
         }
 
-        pluginManager.getActivePlugin()->websocketHook(wsRequest);
-
-        const char *event = wsRequest["event"];
+        const char *event = wsRequest["event"] | "";
 
         if (!strcmp(event, "plugin"))
         {
           int pluginId = wsRequest["plugin"];
 
           Scheduler.clearSchedule();
-          pluginManager.setActivePluginById(pluginId);
-          sendInfo();
+          Commands.post(CMD_SET_PLUGIN, pluginId);
         }
         else if (!strcmp(event, "persist-plugin"))
         {
-          pluginManager.persistActivePlugin();
+          Commands.post(CMD_PERSIST_PLUGIN);
         }
         else if (!strcmp(event, "rotate"))
         {
           bool isRight = (bool)!strcmp(wsRequest["direction"], "right");
-          Screen.setCurrentRotation((Screen.currentRotation + (isRight ? 1 : 3)) % 4, true);
+          Commands.post(CMD_ROTATE, isRight ? 1 : 3);
         }
         else if (!strcmp(event, "info"))
         {
           sendInfo();
         }
+#ifdef ENABLE_REFRESH_METRICS
+        else if (!strcmp(event, "metrics"))
+        {
+          StaticJsonDocument<512> resp;
+          resp["event"] = "metrics";
+          addRefreshMetrics(resp.createNestedObject("metrics"));
+          String out;
+          serializeJson(resp, out);
+          if (ws.availableForWrite(client->id())) {
+            ws.text(client->id(), out);
+          }
+        }
+#endif
         else if (!strcmp(event, "brightness"))
         {
           uint8_t brightness = wsRequest["brightness"].as<uint8_t>();
-          Screen.setBrightness(brightness, true);
+          Commands.post(CMD_BRIGHTNESS, brightness);
         }
         else if (!strcmp(event, "get-animation"))
         {
-          // Minimal fetch: return current frames from Animation plugin as 32-byte arrays
-          Plugin* p = pluginManager.getActivePlugin();
-          if (p && strcmp(p->getName(), "Animation") == 0) {
-            AnimationPlugin* ap = static_cast<AnimationPlugin*>(p);
-            const auto &frames = ap->getFrames();
-            DynamicJsonDocument resp(4096);
-            resp["event"] = "animation-frames";
-            resp["screens"] = (int)frames.size();
-            JsonArray dataArr = resp.createNestedArray("data");
-            for (const auto &f : frames) {
-              JsonArray row = dataArr.createNestedArray();
-              for (int k = 0; k < (int)f.size(); ++k) {
-                row.add(f[k]);
-              }
-            }
-            String out;
-            serializeJson(resp, out);
-            if (ws.availableForWrite(client->id())) {
-              ws.text(client->id(), out);
-            }
-          } else {
-            // Not animation plugin: return empty response
-            DynamicJsonDocument resp(256);
-            resp["event"] = "animation-frames";
-            resp["screens"] = 0;
-            resp.createNestedArray("data");
-            String out;
-            serializeJson(resp, out);
-            if (ws.availableForWrite(client->id())) {
-              ws.text(client->id(), out);
-            }
+          // uploads change the frames on the drawing task, it answers as well
+          if (!Commands.post(CMD_SEND_ANIMATION, client->id()))
+          {
+            Serial.printf("[WS] command queue full, %s dropped\n", event);
+          }
+        }
+        else
+        {
+          // the rest is for plugins, they see it on the drawing task between
+          // frames. The copy is only as large as the event.
+          if (!Commands.post(CMD_PLUGIN_EVENT, 0, new DynamicJsonDocument(wsRequest.as<JsonObjectConst>())))
+          {
+            Serial.printf("[WS] command queue full, %s dropped\n", event);
           }
         }
       }
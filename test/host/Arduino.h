@@ -0,0 +1,74 @@
+#pragma once
+
+// Just enough of Arduino.h for the hardware independent sources built by
+// the native environment. Time only moves when a test moves it.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define constrain(value, low, high) ((value) < (low) ? (low) : ((value) > (high) ? (high) : (value)))
+
+namespace Host
+{
+  inline uint32_t &clockUs()
+  {
+    static uint32_t us = 0;
+    return us;
+  }
+
+  inline void advanceMs(uint32_t ms)
+  {
+    clockUs() += ms * 1000;
+  }
+}
+
+inline unsigned long micros()
+{
+  return Host::clockUs();
+}
+
+inline unsigned long millis()
+{
+  return Host::clockUs() / 1000;
+}
+
+inline long random(long low, long high)
+{
+  return low + rand() % (high - low);
+}
+
+inline long random(long high)
+{
+  return random(0, high);
+}
+
+struct HostSerial
+{
+  void println(const char *text)
+  {
+    puts(text);
+  }
+
+  void printf(const char *format, ...)
+  {
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+  }
+};
+
+inline HostSerial Serial;
@@ -0,0 +1,18 @@
+#pragma once
+
+// The FreeRTOS types and macros the task code uses, for the threading shim
+// in freertos/task.h. One tick is a millisecond like on the ESP32.
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS pdTRUE
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFF)
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms) / portTICK_PERIOD_MS)
+#define portNUM_PROCESSORS 2
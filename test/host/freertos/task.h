@@ -0,0 +1,162 @@
+#pragma once
+
+// FreeRTOS tasks on std::thread, so the task topology can run on the host.
+// Priorities and cores are recorded but not enforced, the host schedules.
+// Task notifications keep their FreeRTOS semantics: a give before the take
+// is not lost, a take with pdTRUE clears the count, a take without a give
+// returns 0 after its ticks. Tasks end by returning, Host::joinTasks()
+// waits for all of them.
+
+#include "FreeRTOS.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string.h>
+#include <thread>
+
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+typedef void (*TaskFunction_t)(void *);
+
+struct HostTask
+{
+  const char *name;
+  uint32_t stack;
+  UBaseType_t priority;
+  BaseType_t core;
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable notified;
+  uint32_t notifications = 0;
+};
+
+typedef HostTask *TaskHandle_t;
+
+namespace Host
+{
+  inline std::mutex &tasksMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  // never shrinks, handles stay valid for the whole test run
+  inline std::deque<HostTask> &tasks()
+  {
+    static std::deque<HostTask> tasks;
+    return tasks;
+  }
+
+  inline HostTask *&currentTask()
+  {
+    thread_local HostTask *task = nullptr;
+    return task;
+  }
+
+  inline void joinTasks()
+  {
+    for (HostTask &task : tasks())
+    {
+      if (task.thread.joinable())
+      {
+        task.thread.join();
+      }
+    }
+  }
+}
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char *name, uint32_t stack, void *parameter,
+                                          UBaseType_t priority, TaskHandle_t *handle, BaseType_t core)
+{
+  HostTask *task;
+  {
+    std::lock_guard<std::mutex> lock(Host::tasksMutex());
+    task = &Host::tasks().emplace_back();
+    task->name = name;
+    task->stack = stack;
+    task->priority = priority;
+    task->core = core;
+  }
+  if (handle)
+  {
+    *handle = task;
+  }
+  task->thread = std::thread([=]()
+                             {
+                               Host::currentTask() = task;
+                               function(parameter); });
+  return pdPASS;
+}
+
+// the thread that calls first becomes a task too, like loopTask
+inline TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+  HostTask *&task = Host::currentTask();
+  if (!task)
+  {
+    std::lock_guard<std::mutex> lock(Host::tasksMutex());
+    task = &Host::tasks().emplace_back();
+    task->name = "loopTask";
+    task->stack = 8192;
+    task->priority = 1;
+    task->core = portNUM_PROCESSORS - 1;
+  }
+  return task;
+}
+
+inline TaskHandle_t xTaskGetHandle(const char *name)
+{
+  std::lock_guard<std::mutex> lock(Host::tasksMutex());
+  for (HostTask &task : Host::tasks())
+  {
+    if (strcmp(task.name, name) == 0)
+    {
+      return &task;
+    }
+  }
+  return nullptr;
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+  {
+    std::lock_guard<std::mutex> lock(task->mutex);
+    task->notifications++;
+  }
+  task->notified.notify_one();
+  return pdPASS;
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks)
+{
+  HostTask *task = xTaskGetCurrentTaskHandle();
+  std::unique_lock<std::mutex> lock(task->mutex);
+  auto given = [task]
+  { return task->notifications > 0; };
+  if (ticks == portMAX_DELAY)
+  {
+    task->notified.wait(lock, given);
+  }
+  else
+  {
+    task->notified.wait_for(lock, std::chrono::milliseconds(ticks * portTICK_PERIOD_MS), given);
+  }
+  uint32_t count = task->notifications;
+  if (count > 0)
+  {
+    task->notifications = clearOnExit ? 0 : count - 1;
+  }
+  return count;
+}
+
+inline void vTaskDelay(TickType_t ticks)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+}
+
+// the host does not measure stacks, a task never used any of its own
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task)
+{
+  return task ? task->stack : 0;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+// lwIP speaks the BSD socket API, on the host the system provides it
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
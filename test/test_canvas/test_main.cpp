@@ -0,0 +1,419 @@
+#include <unity.h>
+#include <chrono>
+#include "canvas.h"
+
+// Canvas primitives against plain per pixel loops, then typical plugin
+// frames drawn through Canvas and through the single pixel calls plugins
+// made on Screen_ before, both timed on the host.
+
+#define PIXELS (ROWS * COLS)
+
+namespace
+{
+  Canvas canvas;
+  uint8_t expected[PIXELS];
+
+  // 8x8, rows MSB first like signs.h
+  const uint8_t SPRITE[8] = {0x3C, 0x7E, 0xDB, 0xFF, 0x7E, 0x24, 0x42, 0x81};
+
+  void setExpected(int x, int y, uint8_t value)
+  {
+    if (x >= 0 && x < COLS && y >= 0 && y < ROWS)
+    {
+      expected[y * COLS + x] = value;
+    }
+  }
+
+  void rectScalar(int x, int y, int width, int height, uint8_t value, bool fill)
+  {
+    for (int row = y; row < y + height; row++)
+    {
+      for (int col = x; col < x + width; col++)
+      {
+        bool edge = row == y || row == y + height - 1 || col == x || col == x + width - 1;
+        if (fill || edge)
+        {
+          setExpected(col, row, value);
+        }
+      }
+    }
+  }
+
+  void blitScalar(int x, int y, const uint8_t *bits, int width, int height, uint8_t value, bool transparent)
+  {
+    for (int row = 0; row < height; row++)
+    {
+      for (int col = 0; col < width; col++)
+      {
+        int bit = row * width + col;
+        if (bits[bit / 8] & (0x80 >> (bit % 8)))
+        {
+          setExpected(x + col, y + row, value);
+        }
+        else if (!transparent)
+        {
+          setExpected(x + col, y + row, 0);
+        }
+      }
+    }
+  }
+
+  // Drawing as plugins did it before Canvas: every call checks its bounds
+  // and flags the buffer around a single byte write, like Screen_::setPixel
+  // did, and lines and rectangles are made of those calls.
+  struct PixelScreen
+  {
+    uint8_t buffer[PIXELS];
+    volatile bool updating = false;
+
+    void setPixel(uint8_t x, uint8_t y, uint8_t value, uint8_t brightness = 255)
+    {
+      if (x >= COLS || y >= ROWS)
+        return;
+      updating = true;
+      buffer[y * COLS + x] = value <= 0 || brightness <= 0 ? 0 : brightness;
+      updating = false;
+    }
+
+    void clear()
+    {
+      updating = true;
+      memset(buffer, 0, PIXELS);
+      updating = false;
+    }
+
+    void drawLine(int x1, int y1, int x2, int y2, int ledStatus, uint8_t brightness = 255)
+    {
+      int dx = abs(x2 - x1);
+      int sx = x1 < x2 ? 1 : -1;
+      int dy = abs(y2 - y1);
+      int sy = y1 < y2 ? 1 : -1;
+      int error = (dx > dy ? dx : -dy) / 2;
+
+      while (x1 != x2 || y1 != y2)
+      {
+        setPixel(x1, y1, ledStatus, brightness);
+        int error2 = error;
+        if (error2 > -dx)
+        {
+          error -= dy;
+          x1 += sx;
+          setPixel(x1, y1, ledStatus, brightness);
+        }
+        else if (error2 < dy)
+        {
+          error += dx;
+          y1 += sy;
+          setPixel(x1, y1, ledStatus, brightness);
+        }
+      }
+    }
+
+    void drawRectangle(int x, int y, int width, int height, bool fill, int ledStatus, uint8_t brightness = 255)
+    {
+      if (!fill)
+      {
+        drawLine(x, y, x + width, y, ledStatus, brightness);
+        drawLine(x, y + 1, x, y + height - 1, ledStatus, brightness);
+        drawLine(x + width, y + 1, x + width, y + height - 1, ledStatus, brightness);
+        drawLine(x, y + height - 1, x + width, y + height - 1, ledStatus, brightness);
+      }
+      else
+      {
+        for (int i = x; i < x + width; i++)
+        {
+          drawLine(i, y, i, y + height - 1, ledStatus, brightness);
+        }
+      }
+    }
+
+    void drawSprite(int x, int y, const uint8_t *bits)
+    {
+      for (int row = 0; row < 8; row++)
+      {
+        for (int col = 0; col < 8; col++)
+        {
+          setPixel(x + col, y + row, bits[row] & (0x80 >> col) ? 1 : 0);
+        }
+      }
+    }
+  };
+
+  PixelScreen screen;
+
+  template <typename Frame>
+  double nsPerFrame(Frame frame)
+  {
+    // best of several batches, the host is busy with other things as well
+    const int batches = 10;
+    const int runs = 2000;
+    double best = 1e9;
+    for (int batch = 0; batch < batches; batch++)
+    {
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < runs; i++)
+      {
+        frame(i);
+        asm volatile("" : : : "memory");
+      }
+      std::chrono::duration<double, std::nano> took = std::chrono::steady_clock::now() - start;
+      best = std::min(best, took.count() / runs);
+    }
+    return best;
+  }
+
+  template <typename Canvased, typename Pixels>
+  void benchmark(const char *name, Canvased canvased, Pixels pixels)
+  {
+    double drawn = nsPerFrame(canvased);
+    double single = nsPerFrame(pixels);
+    char message[96];
+    snprintf(message, sizeof(message), "%-8s %7.1f ns per frame, per pixel %7.1f ns, x%.1f",
+             name, drawn, single, single / drawn);
+    TEST_MESSAGE(message);
+  }
+}
+
+void setUp()
+{
+  canvas.clear();
+  memset(expected, 0, PIXELS);
+}
+
+void tearDown() {}
+
+void test_fill_span_clips()
+{
+  canvas.fillSpan(-3, 0, 6, 9);
+  canvas.fillSpan(COLS - 2, 1, 8, 9);
+  canvas.fillSpan(4, ROWS, 4, 9);
+  canvas.fillSpan(4, -1, 4, 9);
+  canvas.fillSpan(COLS, 2, 4, 9);
+  for (int x = 0; x < 3; x++)
+  {
+    setExpected(x, 0, 9);
+  }
+  setExpected(COLS - 2, 1, 9);
+  setExpected(COLS - 1, 1, 9);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, canvas.pixels, PIXELS);
+}
+
+void test_straight_lines()
+{
+  canvas.drawHLine(12, -4, 3, 7);
+  canvas.drawVLine(5, 20, 10, 8);
+  canvas.drawLine(1, 14, 1, 12, 6);
+  for (int x = 0; x <= 12; x++)
+  {
+    setExpected(x, 3, 7);
+  }
+  for (int y = 10; y < ROWS; y++)
+  {
+    setExpected(5, y, 8);
+  }
+  for (int y = 12; y <= 14; y++)
+  {
+    setExpected(1, y, 6);
+  }
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, canvas.pixels, PIXELS);
+}
+
+void test_diagonal_line()
+{
+  canvas.drawLine(0, 0, 15, 15, 5);
+  for (int i = 0; i < 16; i++)
+  {
+    TEST_ASSERT_EQUAL(5, canvas.getPixel(i, i));
+  }
+
+  canvas.clear();
+  canvas.drawLine(15, 0, 0, 7, 6);
+  TEST_ASSERT_EQUAL(6, canvas.getPixel(15, 0));
+  TEST_ASSERT_EQUAL(6, canvas.getPixel(0, 7));
+  // one pixel per column along the longer axis
+  for (int x = 0; x < 16; x++)
+  {
+    int lit = 0;
+    for (int y = 0; y < 8; y++)
+    {
+      lit += canvas.getPixel(x, y) == 6;
+    }
+    TEST_ASSERT_EQUAL(1, lit);
+  }
+}
+
+void test_rectangles()
+{
+  const int rects[][4] = {
+      {2, 2, 5, 4}, {-2, -2, 5, 5}, {12, 13, 8, 8}, {3, 9, 6, 1}, {10, 6, 4, 2}, {8, 0, 1, 5}, {0, 15, 1, 1}};
+  for (const auto &r : rects)
+  {
+    canvas.clear();
+    memset(expected, 0, PIXELS);
+    canvas.drawRect(r[0], r[1], r[2], r[3], 3);
+    rectScalar(r[0], r[1], r[2], r[3], 3, false);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, canvas.pixels, PIXELS);
+
+    canvas.fillRect(r[0], r[1], r[2], r[3], 4);
+    rectScalar(r[0], r[1], r[2], r[3], 4, true);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, canvas.pixels, PIXELS);
+  }
+
+  // nothing for empty sizes
+  canvas.clear();
+  canvas.drawRect(4, 4, 0, 3, 1);
+  canvas.drawRect(4, 4, 3, -1, 1);
+  canvas.fillRect(4, 4, -2, 3, 1);
+  memset(expected, 0, PIXELS);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, canvas.pixels, PIXELS);
+}
+
+void test_blit()
+{
+  const int places[][2] = {{4, 4}, {-3, 2}, {12, -5}, {10, 11}, {-8, 0}};
+  for (const auto &p : places)
+  {
+    for (int transparent = 0; transparent < 2; transparent++)
+    {
+      canvas.clear(1);
+      memset(expected, 1, PIXELS);
+      canvas.blit(p[0], p[1], SPRITE, 8, 8, 200, transparent);
+      blitScalar(p[0], p[1], SPRITE, 8, 8, 200, transparent);
+      TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, canvas.pixels, PIXELS);
+    }
+  }
+
+  // rows of glyphs that are not a multiple of 8 wide run on
+  const uint8_t narrow[3] = {0xB6, 0xDB, 0x6D};
+  canvas.clear();
+  memset(expected, 0, PIXELS);
+  canvas.blit(1, 1, narrow, 3, 8, 9);
+  blitScalar(1, 1, narrow, 3, 8, 9, false);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, canvas.pixels, PIXELS);
+}
+
+void test_benchmark()
+{
+  // raindrops, a falling trail per column
+  benchmark(
+      "rain",
+      [](int i)
+      {
+        canvas.clear();
+        for (int x = 0; x < COLS; x++)
+        {
+          int head = (i + x * 7) % ROWS;
+          canvas.drawVLine(x, head - 3, head, 64);
+          canvas.setPixel(x, head, 255);
+        }
+      },
+      [](int i)
+      {
+        screen.clear();
+        for (int x = 0; x < COLS; x++)
+        {
+          int head = (i + x * 7) % ROWS;
+          for (int y = head - 3; y < head; y++)
+          {
+            screen.setPixel(x, y, 1, 64);
+          }
+          screen.setPixel(x, head, 1, 255);
+        }
+      });
+
+  // StockChart: grid, a trend line with vertical connectors, baseline
+  benchmark(
+      "chart",
+      [](int i)
+      {
+        canvas.clear();
+        for (int y = 0; y < ROWS; y += 4)
+        {
+          canvas.fillSpan(0, y, COLS, 20);
+        }
+        for (int x = 0; x < COLS; x += 4)
+        {
+          canvas.drawVLine(x, 0, ROWS - 1, 20);
+        }
+        int previous = -1;
+        for (int x = 0; x < COLS; x++)
+        {
+          int y = (i + x * x) % ROWS;
+          canvas.setPixel(x, y, 220);
+          if (previous >= 0)
+          {
+            canvas.drawVLine(x, previous, y, 120);
+          }
+          previous = y;
+        }
+        canvas.fillSpan(0, ROWS - 1, COLS, 30);
+      },
+      [](int i)
+      {
+        screen.clear();
+        for (int y = 0; y < ROWS; y += 4)
+        {
+          for (int x = 0; x < COLS; x++)
+          {
+            screen.setPixel(x, y, 1, 20);
+          }
+        }
+        for (int x = 0; x < COLS; x += 4)
+        {
+          for (int y = 0; y < ROWS; y++)
+          {
+            screen.setPixel(x, y, 1, 20);
+          }
+        }
+        int previous = -1;
+        for (int x = 0; x < COLS; x++)
+        {
+          int y = (i + x * x) % ROWS;
+          screen.setPixel(x, y, 1, 220);
+          if (previous >= 0)
+          {
+            for (int yy = min(previous, y); yy <= max(previous, y); yy++)
+            {
+              screen.setPixel(x, yy, 1, 120);
+            }
+          }
+          previous = y;
+        }
+        for (int x = 0; x < COLS; x++)
+        {
+          screen.setPixel(x, ROWS - 1, 1, 30);
+        }
+      });
+
+  // frames and sprites, like the arcade and Tetris demos
+  benchmark(
+      "shapes",
+      [](int i)
+      {
+        canvas.clear();
+        canvas.drawRect(0, 0, COLS, ROWS, 255);
+        canvas.fillRect(2 + i % 4, 2, 5, 5, 128);
+        canvas.blit(i % 8, 8, SPRITE, 8, 8, 255, true);
+        canvas.blit(8, i % 8, SPRITE, 8, 8);
+      },
+      [](int i)
+      {
+        screen.clear();
+        screen.drawRectangle(0, 0, COLS - 1, ROWS, false, 1);
+        screen.drawRectangle(2 + i % 4, 2, 5, 5, true, 1, 128);
+        screen.drawSprite(i % 8, 8, SPRITE);
+        screen.drawSprite(8, i % 8, SPRITE);
+      });
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_fill_span_clips);
+  RUN_TEST(test_straight_lines);
+  RUN_TEST(test_diagonal_line);
+  RUN_TEST(test_rectangles);
+  RUN_TEST(test_blit);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
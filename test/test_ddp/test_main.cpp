@@ -0,0 +1,269 @@
+#include <unity.h>
+#include <vector>
+#include "ddpreceiver.h"
+#include "lwip/sockets.h"
+
+// A local DDP sender and a socket on loopback standing in for AsyncUDP,
+// which hands every datagram to DDPReceiver like the plugin does. Time
+// only moves when a test moves it.
+
+#define TEST_PORT 40480
+#define PIXELS (ROWS * COLS)
+
+namespace
+{
+  DDPReceiver receiver;
+  int listener = -1;
+  int sender = -1;
+  uint8_t datagram[1500];
+
+  std::vector<uint8_t> packet(uint8_t flags, uint8_t sequence, uint8_t type, uint32_t offset,
+                              const uint8_t *data, uint16_t length, uint32_t timecode = 0)
+  {
+    std::vector<uint8_t> bytes = {(uint8_t)(DDP_VERSION_1 | flags), sequence, type, DDP_ID_DISPLAY,
+                                  (uint8_t)(offset >> 24), (uint8_t)(offset >> 16), (uint8_t)(offset >> 8), (uint8_t)offset,
+                                  (uint8_t)(length >> 8), (uint8_t)length};
+    if (flags & DDP_FLAG_TIMECODE)
+    {
+      for (int shift = 24; shift >= 0; shift -= 8)
+      {
+        bytes.push_back(timecode >> shift);
+      }
+    }
+    bytes.insert(bytes.end(), data, data + length);
+    return bytes;
+  }
+
+  void send(const std::vector<uint8_t> &bytes)
+  {
+    sockaddr_in target = {};
+    target.sin_family = AF_INET;
+    target.sin_port = htons(TEST_PORT);
+    target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sendto(sender, bytes.data(), bytes.size(), 0, (sockaddr *)&target, sizeof(target));
+  }
+
+  // hands everything waiting to the receiver, returns the frames pushed
+  int deliver()
+  {
+    int pushes = 0;
+    int length;
+    while ((length = recv(listener, datagram, sizeof(datagram), MSG_DONTWAIT)) >= 0)
+    {
+      pushes += receiver.receive(datagram, length);
+    }
+    return pushes;
+  }
+
+  // a gray frame of one value in a single pushed packet
+  void sendGray(uint8_t sequence, uint8_t value, uint8_t flags = DDP_FLAG_PUSH, uint32_t timecode = 0)
+  {
+    uint8_t pixels[PIXELS];
+    memset(pixels, value, PIXELS);
+    send(packet(flags, sequence, DDP_TYPE_GRAY8, 0, pixels, PIXELS, timecode));
+  }
+}
+
+void setUp()
+{
+  // whatever an earlier test numbered is forgotten
+  Host::advanceMs(10000);
+  receiver.reset();
+  listener = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  int reuse = 1;
+  setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(TEST_PORT);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  TEST_ASSERT_EQUAL(0, bind(listener, (sockaddr *)&address, sizeof(address)));
+  sender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+}
+
+void tearDown()
+{
+  close(listener);
+  close(sender);
+}
+
+void test_rgb_frame_in_one_packet()
+{
+  uint8_t pixels[PIXELS * 3];
+  for (int i = 0; i < PIXELS * 3; i++)
+  {
+    pixels[i] = i;
+  }
+  send(packet(DDP_FLAG_PUSH, 1, DDP_TYPE_RGB8, 0, pixels, sizeof(pixels)));
+  TEST_ASSERT_EQUAL(1, deliver());
+  TEST_ASSERT_EQUAL(INGEST_RGB8, receiver.getFormat());
+  TEST_ASSERT_EQUAL(PIXELS * 3, receiver.getFrameSize());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(pixels, receiver.getChannels(), sizeof(pixels));
+  TEST_ASSERT_EQUAL(1, receiver.stats.frames);
+}
+
+void test_undefined_type_is_rgb()
+{
+  uint8_t pixels[PIXELS * 3] = {};
+  send(packet(DDP_FLAG_PUSH, 0, DDP_TYPE_UNDEFINED, 0, pixels, sizeof(pixels)));
+  TEST_ASSERT_EQUAL(1, deliver());
+  TEST_ASSERT_EQUAL(INGEST_RGB8, receiver.getFormat());
+}
+
+void test_gray_frame()
+{
+  sendGray(1, 77);
+  TEST_ASSERT_EQUAL(1, deliver());
+  TEST_ASSERT_EQUAL(INGEST_GRAY8, receiver.getFormat());
+  TEST_ASSERT_EQUAL(PIXELS, receiver.getFrameSize());
+  TEST_ASSERT_EQUAL(77, receiver.getChannels()[PIXELS - 1]);
+}
+
+void test_frame_over_packets_up_to_push()
+{
+  uint8_t pixels[PIXELS];
+  for (int i = 0; i < PIXELS; i++)
+  {
+    pixels[i] = 255 - i;
+  }
+  // in any order, only the push shows the frame
+  send(packet(0, 1, DDP_TYPE_GRAY8, 100, pixels + 100, 100));
+  send(packet(0, 2, DDP_TYPE_GRAY8, 0, pixels, 100));
+  TEST_ASSERT_EQUAL(0, deliver());
+  send(packet(DDP_FLAG_PUSH, 3, DDP_TYPE_GRAY8, 200, pixels + 200, PIXELS - 200));
+  TEST_ASSERT_EQUAL(1, deliver());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(pixels, receiver.getChannels(), PIXELS);
+
+  // the next frame only changes a part, the rest stays
+  uint8_t patch[4] = {1, 2, 3, 4};
+  send(packet(DDP_FLAG_PUSH, 4, DDP_TYPE_GRAY8, 10, patch, 4));
+  TEST_ASSERT_EQUAL(1, deliver());
+  TEST_ASSERT_EQUAL(3, receiver.getChannels()[12]);
+  TEST_ASSERT_EQUAL(pixels[14], receiver.getChannels()[14]);
+}
+
+void test_data_past_the_panel()
+{
+  uint8_t pixels[PIXELS];
+  memset(pixels, 9, PIXELS);
+  // clipped at the end of the panel, or ignored entirely
+  send(packet(0, 0, DDP_TYPE_GRAY8, PIXELS - 4, pixels, 8));
+  send(packet(DDP_FLAG_PUSH, 0, DDP_TYPE_GRAY8, PIXELS, pixels, 8));
+  TEST_ASSERT_EQUAL(1, deliver());
+  TEST_ASSERT_EQUAL(0, receiver.getChannels()[PIXELS - 5]);
+  TEST_ASSERT_EQUAL(9, receiver.getChannels()[PIXELS - 1]);
+  TEST_ASSERT_EQUAL(0, receiver.stats.malformed);
+}
+
+void test_malformed()
+{
+  uint8_t pixels[16] = {};
+  std::vector<uint8_t> bytes = packet(DDP_FLAG_PUSH, 1, DDP_TYPE_GRAY8, 0, pixels, 16);
+
+  std::vector<uint8_t> shortHeader(bytes.begin(), bytes.begin() + DDP_HEADER_SIZE - 1);
+  send(shortHeader);
+  std::vector<uint8_t> version = bytes;
+  version[0] = 0x80 | DDP_FLAG_PUSH;
+  send(version);
+  send(packet(DDP_FLAG_PUSH | DDP_FLAG_QUERY, 1, DDP_TYPE_GRAY8, 0, pixels, 16));
+  std::vector<uint8_t> config = bytes;
+  config[3] = 250;
+  send(config);
+  send(packet(DDP_FLAG_PUSH, 1, 0x1B, 0, pixels, 16));
+  std::vector<uint8_t> truncated = bytes;
+  truncated.pop_back();
+  send(truncated);
+  std::vector<uint8_t> noTimecode = packet(DDP_FLAG_PUSH | DDP_FLAG_TIMECODE, 1, DDP_TYPE_GRAY8, 0, pixels, 0, 5);
+  noTimecode.resize(DDP_HEADER_SIZE + 2);
+  send(noTimecode);
+
+  TEST_ASSERT_EQUAL(0, deliver());
+  TEST_ASSERT_EQUAL(7, receiver.stats.packets);
+  TEST_ASSERT_EQUAL(7, receiver.stats.malformed);
+  TEST_ASSERT_EQUAL(0, receiver.stats.frames);
+}
+
+void test_sequence_numbers()
+{
+  sendGray(5, 1);
+  // duplicate, and late within the window
+  sendGray(5, 2);
+  sendGray(2, 3);
+  TEST_ASSERT_EQUAL(1, deliver());
+  TEST_ASSERT_EQUAL(2, receiver.stats.outOfOrder);
+  TEST_ASSERT_EQUAL(1, receiver.getChannels()[0]);
+
+  // gaps are fine, 15 wraps to 1 and 0 is never checked
+  sendGray(9, 4);
+  sendGray(15, 5);
+  sendGray(1, 6);
+  sendGray(0, 7);
+  sendGray(2, 8);
+  TEST_ASSERT_EQUAL(5, deliver());
+  TEST_ASSERT_EQUAL(8, receiver.getChannels()[0]);
+
+  // after a pause any number starts over
+  Host::advanceMs(DDP_SEQUENCE_RESET_MS + 1);
+  sendGray(1, 9);
+  TEST_ASSERT_EQUAL(1, deliver());
+  TEST_ASSERT_EQUAL(2, receiver.stats.outOfOrder);
+}
+
+void test_stale_timecode()
+{
+  sendGray(0, 1, DDP_FLAG_PUSH | DDP_FLAG_TIMECODE, 1000);
+  sendGray(0, 2, DDP_FLAG_PUSH | DDP_FLAG_TIMECODE, 999);
+  sendGray(0, 3, DDP_FLAG_PUSH | DDP_FLAG_TIMECODE, 1001);
+  TEST_ASSERT_EQUAL(2, deliver());
+  TEST_ASSERT_EQUAL(1, receiver.stats.staleFrames);
+  TEST_ASSERT_EQUAL(3, receiver.getChannels()[0]);
+
+  // timecodes wrap as well
+  sendGray(0, 4, DDP_FLAG_PUSH | DDP_FLAG_TIMECODE, 0x70000000);
+  sendGray(0, 5, DDP_FLAG_PUSH | DDP_FLAG_TIMECODE, 0xE0000000);
+  sendGray(0, 6, DDP_FLAG_PUSH | DDP_FLAG_TIMECODE, 0x10);
+  TEST_ASSERT_EQUAL(3, deliver());
+  TEST_ASSERT_EQUAL(6, receiver.getChannels()[0]);
+  TEST_ASSERT_EQUAL(1, receiver.stats.staleFrames);
+}
+
+void test_format_change_clears_frame()
+{
+  sendGray(0, 50);
+  uint8_t rgb[3] = {10, 20, 30};
+  send(packet(DDP_FLAG_PUSH, 0, DDP_TYPE_RGB8, 0, rgb, 3));
+  TEST_ASSERT_EQUAL(2, deliver());
+  TEST_ASSERT_EQUAL(INGEST_RGB8, receiver.getFormat());
+  TEST_ASSERT_EQUAL(30, receiver.getChannels()[2]);
+  TEST_ASSERT_EQUAL(0, receiver.getChannels()[3]);
+}
+
+void test_rates()
+{
+  for (int i = 0; i < 10; i++)
+  {
+    sendGray(0, i, i % 2 ? DDP_FLAG_PUSH : 0);
+    deliver();
+    Host::advanceMs(100);
+  }
+  // the packet that closes the window counts in it
+  sendGray(0, 0, 0);
+  deliver();
+  TEST_ASSERT_EQUAL(11, receiver.stats.packetsPerSecond);
+  TEST_ASSERT_EQUAL(5, receiver.stats.framesPerSecond);
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_rgb_frame_in_one_packet);
+  RUN_TEST(test_undefined_type_is_rgb);
+  RUN_TEST(test_gray_frame);
+  RUN_TEST(test_frame_over_packets_up_to_push);
+  RUN_TEST(test_data_past_the_panel);
+  RUN_TEST(test_malformed);
+  RUN_TEST(test_sequence_numbers);
+  RUN_TEST(test_stale_timecode);
+  RUN_TEST(test_format_change_clears_frame);
+  RUN_TEST(test_rates);
+  return UNITY_END();
+}
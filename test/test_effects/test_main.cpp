@@ -0,0 +1,276 @@
+#include <unity.h>
+#include <chrono>
+#include "effects.h"
+
+// Every kernel against a per pixel version of itself, on random frames and
+// over the whole range of its parameter, then both timed on the host.
+
+#define PIXELS (ROWS * COLS)
+
+namespace
+{
+  uint8_t frame[PIXELS];
+  uint8_t other[PIXELS];
+  uint8_t expected[PIXELS];
+
+  void randomFrame(uint8_t *buffer)
+  {
+    for (int i = 0; i < PIXELS; i++)
+    {
+      buffer[i] = rand();
+    }
+    // the edges the lanes are most likely to get wrong
+    buffer[0] = 0;
+    buffer[1] = 255;
+    buffer[2] = 1;
+    buffer[3] = 254;
+  }
+
+  void scaleScalar(uint8_t *buffer, uint16_t factor)
+  {
+    for (int i = 0; i < PIXELS; i++)
+    {
+      buffer[i] = factor >= 256 ? buffer[i] : buffer[i] * factor >> 8;
+    }
+  }
+
+  void decayScalar(uint8_t *buffer, uint8_t amount)
+  {
+    for (int i = 0; i < PIXELS; i++)
+    {
+      buffer[i] = buffer[i] > amount ? buffer[i] - amount : 0;
+    }
+  }
+
+  void addSaturateScalar(uint8_t *buffer, const uint8_t *source)
+  {
+    for (int i = 0; i < PIXELS; i++)
+    {
+      buffer[i] = min(buffer[i] + source[i], 255);
+    }
+  }
+
+  void thresholdScalar(uint8_t *buffer, uint8_t level, uint8_t on)
+  {
+    for (int i = 0; i < PIXELS; i++)
+    {
+      buffer[i] = buffer[i] > level ? on : 0;
+    }
+  }
+
+  void quantizeScalar(uint8_t *buffer, const uint8_t *thresholds, const uint8_t *values, int count)
+  {
+    for (int i = 0; i < PIXELS; i++)
+    {
+      uint8_t result = 0;
+      for (int step = 0; step < count; step++)
+      {
+        if (buffer[i] > thresholds[step])
+        {
+          result = values[step];
+        }
+      }
+      buffer[i] = result;
+    }
+  }
+
+  void shiftScalar(uint8_t *buffer, Effects::Direction direction, bool wrap, uint8_t fill)
+  {
+    uint8_t source[PIXELS];
+    memcpy(source, buffer, PIXELS);
+    int dx = direction == Effects::LEFT ? 1 : direction == Effects::RIGHT ? -1 : 0;
+    int dy = direction == Effects::UP ? 1 : direction == Effects::DOWN ? -1 : 0;
+    for (int y = 0; y < ROWS; y++)
+    {
+      for (int x = 0; x < COLS; x++)
+      {
+        int sx = x + dx;
+        int sy = y + dy;
+        bool inside = sx >= 0 && sx < COLS && sy >= 0 && sy < ROWS;
+        if (inside || wrap)
+        {
+          buffer[y * COLS + x] = source[(sy + ROWS) % ROWS * COLS + (sx + COLS) % COLS];
+        }
+        else
+        {
+          buffer[y * COLS + x] = fill;
+        }
+      }
+    }
+  }
+
+  // The kernels work in place and most of them run a frame into zeros or a
+  // fixed point within a few calls, so every run starts from the same random
+  // input. Copying it back is timed alone and taken off.
+  uint8_t input[PIXELS];
+
+  // best of several batches, the host is busy with other things as well
+  template <typename Kernel>
+  double nsPerRun(Kernel kernel)
+  {
+    const int batches = 10;
+    const int runs = 2000;
+    double best = 1e9;
+    for (int batch = 0; batch < batches; batch++)
+    {
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < runs; i++)
+      {
+        memcpy(frame, input, PIXELS);
+        kernel();
+        // keeps the copy and the kernel from being merged across runs
+        asm volatile("" : : "r"(frame) : "memory");
+      }
+      std::chrono::duration<double, std::nano> took = std::chrono::steady_clock::now() - start;
+      best = std::min(best, took.count() / runs);
+    }
+    return best;
+  }
+
+  template <typename Kernel>
+  double nsPerFrame(Kernel kernel)
+  {
+    return nsPerRun(kernel) - nsPerRun([] {});
+  }
+
+  template <typename Word, typename Scalar>
+  void benchmark(const char *name, Word word, Scalar scalar)
+  {
+    double words = nsPerFrame(word);
+    double pixels = nsPerFrame(scalar);
+    char message[96];
+    snprintf(message, sizeof(message), "%-12s %7.1f ns per frame, per pixel %7.1f ns, x%.1f",
+             name, words, pixels, pixels / words);
+    TEST_MESSAGE(message);
+  }
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_scale()
+{
+  for (uint16_t factor = 0; factor <= 256; factor++)
+  {
+    randomFrame(frame);
+    memcpy(expected, frame, PIXELS);
+    Effects::scale(frame, factor);
+    scaleScalar(expected, factor);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, frame, PIXELS);
+  }
+}
+
+void test_decay()
+{
+  for (int amount = 0; amount <= 255; amount++)
+  {
+    randomFrame(frame);
+    memcpy(expected, frame, PIXELS);
+    Effects::decay(frame, amount);
+    decayScalar(expected, amount);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, frame, PIXELS);
+  }
+}
+
+void test_add_saturate()
+{
+  for (int run = 0; run < 256; run++)
+  {
+    randomFrame(frame);
+    randomFrame(other);
+    memcpy(expected, frame, PIXELS);
+    Effects::addSaturate(frame, other);
+    addSaturateScalar(expected, other);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, frame, PIXELS);
+  }
+}
+
+void test_threshold()
+{
+  for (int level = 0; level <= 255; level++)
+  {
+    randomFrame(frame);
+    memcpy(expected, frame, PIXELS);
+    Effects::threshold(frame, level, 200);
+    thresholdScalar(expected, level, 200);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, frame, PIXELS);
+  }
+}
+
+void test_quantize()
+{
+  // the steps RainPlugin uses
+  const uint8_t thresholds[] = {25, 50, 75};
+  const uint8_t values[] = {16, 32, 64};
+  for (int run = 0; run < 256; run++)
+  {
+    randomFrame(frame);
+    memcpy(expected, frame, PIXELS);
+    Effects::quantize(frame, thresholds, values, 3);
+    quantizeScalar(expected, thresholds, values, 3);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, frame, PIXELS);
+  }
+
+  // the ends of the range and repeated thresholds
+  const uint8_t edges[] = {0, 128, 128, 254, 255};
+  const uint8_t edgeValues[] = {10, 20, 30, 40, 50};
+  for (int count = 0; count <= 5; count++)
+  {
+    randomFrame(frame);
+    memcpy(expected, frame, PIXELS);
+    Effects::quantize(frame, edges, edgeValues, count);
+    quantizeScalar(expected, edges, edgeValues, count);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, frame, PIXELS);
+  }
+}
+
+void test_shift()
+{
+  const Effects::Direction directions[] = {Effects::LEFT, Effects::RIGHT, Effects::UP, Effects::DOWN};
+  for (Effects::Direction direction : directions)
+  {
+    for (int wrap = 0; wrap < 2; wrap++)
+    {
+      randomFrame(frame);
+      memcpy(expected, frame, PIXELS);
+      Effects::shift(frame, direction, wrap, 7);
+      shiftScalar(expected, direction, wrap, 7);
+      TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, frame, PIXELS);
+    }
+  }
+}
+
+void test_benchmark()
+{
+  static const uint8_t thresholds[] = {25, 50, 75};
+  static const uint8_t values[] = {16, 32, 64};
+  randomFrame(input);
+  randomFrame(other);
+  benchmark(
+      "scale", [] { Effects::scale(frame, 250); }, [] { scaleScalar(frame, 250); });
+  benchmark(
+      "decay", [] { Effects::decay(frame, 1); }, [] { decayScalar(frame, 1); });
+  benchmark(
+      "addSaturate", [] { Effects::addSaturate(frame, other); }, [] { addSaturateScalar(frame, other); });
+  benchmark(
+      "threshold", [] { Effects::threshold(frame, 128); }, [] { thresholdScalar(frame, 128, 255); });
+  benchmark(
+      "quantize", [] { Effects::quantize(frame, thresholds, values, 3); },
+      [] { quantizeScalar(frame, thresholds, values, 3); });
+  benchmark(
+      "shift left", [] { Effects::shift(frame, Effects::LEFT, true); },
+      [] { shiftScalar(frame, Effects::LEFT, true, 0); });
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_scale);
+  RUN_TEST(test_decay);
+  RUN_TEST(test_add_saturate);
+  RUN_TEST(test_threshold);
+  RUN_TEST(test_quantize);
+  RUN_TEST(test_shift);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
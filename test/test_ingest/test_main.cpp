@@ -0,0 +1,198 @@
+#include <unity.h>
+#include <chrono>
+#include "ingestkernels.h"
+
+// The ingest kernels against per pixel versions of themselves, then both
+// timed on the host.
+
+#define PIXELS (ROWS * COLS)
+
+using namespace IngestKernels;
+
+namespace
+{
+  uint8_t source[PIXELS * 3];
+  uint8_t frame[PIXELS];
+  uint8_t expected[PIXELS];
+
+  void randomBytes(uint8_t *buffer, size_t length)
+  {
+    for (size_t i = 0; i < length; i++)
+    {
+      buffer[i] = rand();
+    }
+    // white and black pixels, the ends the weights must keep
+    memset(buffer, 255, 6);
+    memset(buffer + 6, 0, 6);
+  }
+
+  void rgbToLumaScalar(uint8_t *target, const uint8_t *rgb, const uint8_t *weights)
+  {
+    for (int i = 0; i < PIXELS; i++)
+    {
+      target[i] = (rgb[i * 3] * weights[0] + rgb[i * 3 + 1] * weights[1] + rgb[i * 3 + 2] * weights[2]) >> 8;
+    }
+  }
+
+  void gray4ToGray8Scalar(uint8_t *target, const uint8_t *packed)
+  {
+    for (int i = 0; i < PIXELS; i++)
+    {
+      uint8_t nibble = i % 2 ? packed[i / 2] & 0x0F : packed[i / 2] >> 4;
+      target[i] = nibble * 17;
+    }
+  }
+
+  void mono1ToGray8Scalar(uint8_t *target, const uint8_t *packed, uint8_t on)
+  {
+    for (int i = 0; i < PIXELS; i++)
+    {
+      target[i] = packed[i / 8] & (0x80 >> (i % 8)) ? on : 0;
+    }
+  }
+
+  template <typename Kernel>
+  double nsPerFrame(Kernel kernel)
+  {
+    const int runs = 20000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++)
+    {
+      kernel();
+    }
+    std::chrono::duration<double, std::nano> took = std::chrono::steady_clock::now() - start;
+    return took.count() / runs;
+  }
+
+  template <typename Word, typename Scalar>
+  void benchmark(const char *name, Word word, Scalar scalar)
+  {
+    double words = nsPerFrame(word);
+    double pixels = nsPerFrame(scalar);
+    char message[96];
+    snprintf(message, sizeof(message), "%-8s %7.1f ns per frame, per pixel %7.1f ns, x%.1f",
+             name, words, pixels, pixels / words);
+    TEST_MESSAGE(message);
+  }
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_frame_size()
+{
+  TEST_ASSERT_EQUAL(PIXELS * 3, frameSize(INGEST_RGB8));
+  TEST_ASSERT_EQUAL(PIXELS, frameSize(INGEST_GRAY8));
+  TEST_ASSERT_EQUAL(PIXELS / 2, frameSize(INGEST_GRAY4));
+  TEST_ASSERT_EQUAL(PIXELS / 8, frameSize(INGEST_MONO1));
+}
+
+void test_rgb_to_luma()
+{
+  const LumaWeights weights[] = {LUMA_AVERAGE, LUMA_BT601, LUMA_BT709};
+  for (LumaWeights luma : weights)
+  {
+    const uint8_t *set = lumaWeights(luma);
+    TEST_ASSERT_EQUAL(256, set[0] + set[1] + set[2]);
+    for (int run = 0; run < 64; run++)
+    {
+      randomBytes(source, PIXELS * 3);
+      rgbToLuma(frame, source, set);
+      rgbToLumaScalar(expected, source, set);
+      TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, frame, PIXELS);
+      TEST_ASSERT_EQUAL(255, frame[0]);
+      TEST_ASSERT_EQUAL(0, frame[2]);
+    }
+  }
+}
+
+void test_gray4_to_gray8()
+{
+  for (int run = 0; run < 64; run++)
+  {
+    randomBytes(source, PIXELS / 2);
+    gray4ToGray8(frame, source);
+    gray4ToGray8Scalar(expected, source);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, frame, PIXELS);
+  }
+}
+
+void test_mono1_to_gray8()
+{
+  for (int on = 0; on <= 255; on += 51)
+  {
+    randomBytes(source, PIXELS / 8);
+    mono1ToGray8(frame, source, on);
+    mono1ToGray8Scalar(expected, source, on);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, frame, PIXELS);
+  }
+}
+
+void test_lut()
+{
+  uint8_t lut[256];
+  TEST_ASSERT_TRUE(buildLut(lut, 1.0f, 0));
+  for (int i = 0; i < 256; i++)
+  {
+    TEST_ASSERT_EQUAL(i, lut[i]);
+  }
+
+  TEST_ASSERT_FALSE(buildLut(lut, 1.0f, 4));
+  for (int i = 0; i < 256; i++)
+  {
+    TEST_ASSERT_EQUAL(i <= 4 ? 0 : i, lut[i]);
+  }
+
+  TEST_ASSERT_FALSE(buildLut(lut, 2.2f, 0));
+  TEST_ASSERT_EQUAL(0, lut[0]);
+  TEST_ASSERT_EQUAL(255, lut[255]);
+  TEST_ASSERT_EQUAL(56, lut[128]);
+  for (int i = 1; i < 256; i++)
+  {
+    TEST_ASSERT_TRUE(lut[i] >= lut[i - 1]);
+  }
+
+  randomBytes(frame, PIXELS);
+  memcpy(expected, frame, PIXELS);
+  applyLut(frame, lut);
+  for (int i = 0; i < PIXELS; i++)
+  {
+    TEST_ASSERT_EQUAL(lut[expected[i]], frame[i]);
+  }
+}
+
+void test_hash()
+{
+  randomBytes(frame, PIXELS);
+  memcpy(expected, frame, PIXELS);
+  TEST_ASSERT_EQUAL_UINT32(hashFrame(expected), hashFrame(frame));
+  for (int i = 0; i < PIXELS; i += 17)
+  {
+    frame[i] ^= 1;
+    TEST_ASSERT_TRUE(hashFrame(frame) != hashFrame(expected));
+    frame[i] ^= 1;
+  }
+}
+
+void test_benchmark()
+{
+  // rgb8 is converted per pixel already
+  randomBytes(source, PIXELS * 3);
+  benchmark(
+      "gray4", [] { gray4ToGray8(frame, source); }, [] { gray4ToGray8Scalar(frame, source); });
+  benchmark(
+      "mono1", [] { mono1ToGray8(frame, source, 255); }, [] { mono1ToGray8Scalar(frame, source, 255); });
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_frame_size);
+  RUN_TEST(test_rgb_to_luma);
+  RUN_TEST(test_gray4_to_gray8);
+  RUN_TEST(test_mono1_to_gray8);
+  RUN_TEST(test_lut);
+  RUN_TEST(test_hash);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
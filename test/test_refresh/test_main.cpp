@@ -0,0 +1,193 @@
+#include <unity.h>
+#include <chrono>
+#include "subframes.h"
+
+// The PWM and BCM encodings Screen_ refreshes the panel with: every value
+// has to stay lit for its gray level worth of base intervals, then both
+// modes are driven through one second of refresh ticks to compare the
+// interrupt load and the refresh rate.
+
+#define PIXELS (ROWS * COLS)
+#define SPI_CLOCK_HZ 10000000 // as Screen_::setup() configures the bus
+
+namespace
+{
+  const Subframes::Mode MODES[2] = {Subframes::PWM, Subframes::BCM};
+  const char *NAMES[2] = {"pwm", "bcm"};
+  const uint32_t BASE_US[2] = {TIMER_INTERVAL_US, BCM_LSB_US};
+
+  uint8_t subframes[GRAY_LEVELS][SUBFRAME_BYTES];
+  uint8_t frame[PIXELS];
+
+  // base intervals position is latched on during one refresh
+  uint32_t litPeriods(Subframes::Mode mode, int position, uint8_t shift)
+  {
+    uint32_t periods = 0;
+    for (int subframe = 0; subframe < Subframes::count(mode, shift); subframe++)
+    {
+      if (subframes[subframe][position >> 3] & (0x80 >> (position & 7)))
+      {
+        periods += Subframes::intervalUs(mode, 1, subframe);
+      }
+    }
+    return periods;
+  }
+
+  uint32_t refreshUs(Subframes::Mode mode, uint32_t baseUs, uint8_t shift)
+  {
+    uint32_t us = 0;
+    for (int subframe = 0; subframe < Subframes::count(mode, shift); subframe++)
+    {
+      us += Subframes::intervalUs(mode, baseUs, subframe);
+    }
+    return us;
+  }
+
+  void encode(Subframes::Mode mode, uint8_t shift)
+  {
+    for (int position = 0; position < PIXELS; position++)
+    {
+      Subframes::writePixel(mode, &subframes[0][0], position, frame[position], shift);
+    }
+  }
+
+  template <typename Run>
+  double nsPerRun(Run run, int runs)
+  {
+    // best of several batches, the host is busy with other things as well
+    double best = 1e9;
+    for (int batch = 0; batch < 10; batch++)
+    {
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < runs; i++)
+      {
+        run(i);
+        asm volatile("" : : : "memory");
+      }
+      std::chrono::duration<double, std::nano> took = std::chrono::steady_clock::now() - start;
+      best = std::min(best, took.count() / runs);
+    }
+    return best;
+  }
+}
+
+void setUp()
+{
+  memset(subframes, 0, sizeof(subframes));
+}
+
+void tearDown() {}
+
+void test_gray_levels()
+{
+  for (int m = 0; m < 2; m++)
+  {
+    for (uint8_t shift = 0; shift <= 3; shift++)
+    {
+      uint32_t full = Subframes::refreshPeriods(MODES[m], shift);
+      TEST_ASSERT_EQUAL(full, refreshUs(MODES[m], 1, shift));
+
+      uint32_t previous = 0;
+      for (int value = 0; value < 256; value++)
+      {
+        Subframes::writePixel(MODES[m], &subframes[0][0], 5, value, shift);
+        uint32_t lit = litPeriods(MODES[m], 5, shift);
+        TEST_ASSERT_EQUAL(Subframes::grayLevel(MODES[m], value, shift), lit);
+        TEST_ASSERT_TRUE(lit >= previous);
+        TEST_ASSERT_EQUAL(lit > 0 && lit < full, Subframes::needsModulation(MODES[m], value, shift));
+        previous = lit;
+      }
+      // off stays off, the dimmest value stays visible, full is always on
+      TEST_ASSERT_EQUAL(0, Subframes::grayLevel(MODES[m], 0, shift));
+      TEST_ASSERT_EQUAL(1, Subframes::grayLevel(MODES[m], 1, shift));
+      TEST_ASSERT_EQUAL(full, previous);
+    }
+  }
+}
+
+void test_pixels_independent()
+{
+  for (int m = 0; m < 2; m++)
+  {
+    for (int i = 0; i < PIXELS; i++)
+    {
+      frame[i] = random(256);
+    }
+    memset(subframes, 0xFF, sizeof(subframes));
+    encode(MODES[m], 0);
+    for (int position = 0; position < PIXELS; position++)
+    {
+      TEST_ASSERT_EQUAL(Subframes::grayLevel(MODES[m], frame[position], 0), litPeriods(MODES[m], position, 0));
+    }
+  }
+}
+
+void test_benchmark()
+{
+  uint32_t ticksPerSecond[2];
+  double refreshHz[2];
+  for (int m = 0; m < 2; m++)
+  {
+    Subframes::Mode mode = MODES[m];
+    int count = Subframes::count(mode, 0);
+    for (int i = 0; i < PIXELS; i++)
+    {
+      frame[i] = random(256);
+    }
+    encode(mode, 0);
+
+    // the refresh interrupt for one simulated second: latch the subframe,
+    // shift it out byte by byte as SPI.writeBytes() does, pick the next
+    // interval. Counts the ticks that fit into the second.
+    volatile uint8_t spi;
+    uint32_t ticks = 0;
+    double hostNs = nsPerRun(
+        [&](int)
+        {
+          uint32_t elapsedUs = 0;
+          int subframe = 0;
+          ticks = 0;
+          while (elapsedUs < 1000000)
+          {
+            for (int i = 0; i < SUBFRAME_BYTES; i++)
+            {
+              spi = subframes[subframe][i];
+            }
+            elapsedUs += Subframes::intervalUs(mode, BASE_US[m], subframe);
+            subframe = subframe + 1 < count ? subframe + 1 : 0;
+            ticks++;
+          }
+        },
+        20);
+    (void)spi;
+
+    // commit time: BCM encodes 6 planes per pixel where PWM writes 64
+    double encodeNs = nsPerRun([&](int)
+                               { encode(mode, 0); },
+                               200);
+
+    ticksPerSecond[m] = ticks;
+    refreshHz[m] = 1e6 / refreshUs(mode, BASE_US[m], 0);
+    // on the panel every tick waits for the whole subframe on the bus
+    double spiShare = ticks * (SUBFRAME_BYTES * 8.0 / SPI_CLOCK_HZ);
+
+    char message[160];
+    snprintf(message, sizeof(message),
+             "%-4s %5u ticks/s, refresh %6.1f Hz, isr %5.1f%% with SPI at 10 MHz, %5.1f ns per tick on the host, encode %8.1f ns",
+             NAMES[m], (unsigned)ticks, refreshHz[m], spiShare * 100, hostNs / ticks, encodeNs);
+    TEST_MESSAGE(message);
+  }
+
+  // fewer interrupts for a faster refresh at the same 64 gray levels
+  TEST_ASSERT_TRUE(ticksPerSecond[1] * 4 < ticksPerSecond[0]);
+  TEST_ASSERT_TRUE(refreshHz[1] > refreshHz[0] * 2);
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_gray_levels);
+  RUN_TEST(test_pixels_independent);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
@@ -0,0 +1,285 @@
+#include <unity.h>
+#include <vector>
+#include "sacnreceiver.h"
+
+// A local E1.31 sender drives SACNReceiver over loopback, unicast to the
+// port it listens on. Time only moves when a test moves it.
+
+#define TEST_PORT 55680
+
+namespace
+{
+  const uint8_t SOURCE_A[16] = {0xA0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+  const uint8_t SOURCE_B[16] = {0xB0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+  SACNReceiver receiver;
+  int sender = -1;
+
+  void put16(std::vector<uint8_t> &packet, size_t offset, uint16_t value)
+  {
+    packet[offset] = value >> 8;
+    packet[offset + 1] = value;
+  }
+
+  void put32(std::vector<uint8_t> &packet, size_t offset, uint32_t value)
+  {
+    put16(packet, offset, value >> 16);
+    put16(packet, offset + 2, value);
+  }
+
+  // preamble, root layer and the flags and length of every PDU
+  std::vector<uint8_t> rootLayer(size_t size, uint32_t vector, const uint8_t *cid)
+  {
+    std::vector<uint8_t> packet(size);
+    put16(packet, 0, 0x0010);
+    memcpy(&packet[4], "ASC-E1.17\0\0\0", 12);
+    put16(packet, 16, 0x7000 | (size - 16));
+    put32(packet, 18, vector);
+    memcpy(&packet[22], cid, 16);
+    put16(packet, 38, 0x7000 | (size - 38));
+    return packet;
+  }
+
+  std::vector<uint8_t> dataPacket(const uint8_t *cid, uint16_t universe, uint8_t priority, uint8_t sequence,
+                                  uint8_t value, uint16_t syncAddress = 0, uint8_t options = 0)
+  {
+    const uint16_t slots = DMX_SLOTS;
+    std::vector<uint8_t> packet = rootLayer(SACN_DATA_HEADER_SIZE + slots, SACN_ROOT_VECTOR_DATA, cid);
+    put32(packet, 40, SACN_FRAMING_VECTOR_DATA);
+    memcpy(&packet[44], "test_sacn", 9);
+    packet[108] = priority;
+    put16(packet, 109, syncAddress);
+    packet[111] = sequence;
+    packet[112] = options;
+    put16(packet, 113, universe);
+    put16(packet, 115, 0x7000 | (packet.size() - 115));
+    packet[117] = 0x02;
+    packet[118] = 0xA1;
+    put16(packet, 121, 1);
+    put16(packet, 123, slots + 1);
+    memset(&packet[SACN_DATA_HEADER_SIZE], value, slots);
+    return packet;
+  }
+
+  std::vector<uint8_t> syncPacket(const uint8_t *cid, uint16_t address, uint8_t sequence)
+  {
+    std::vector<uint8_t> packet = rootLayer(SACN_SYNC_PACKET_SIZE, SACN_ROOT_VECTOR_EXTENDED, cid);
+    put32(packet, 40, SACN_FRAMING_VECTOR_SYNC);
+    packet[44] = sequence;
+    put16(packet, 45, address);
+    return packet;
+  }
+
+  void send(const std::vector<uint8_t> &packet)
+  {
+    sockaddr_in target = {};
+    target.sin_family = AF_INET;
+    target.sin_port = htons(TEST_PORT);
+    target.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sendto(sender, packet.data(), packet.size(), 0, (sockaddr *)&target, sizeof(target));
+  }
+
+  // value of the first pixel of the frame that completed, -1 for none
+  int shown()
+  {
+    receiver.poll();
+    uint32_t completeUs;
+    const uint8_t *pixels = receiver.frame.take(completeUs);
+    return pixels ? pixels[0] : -1;
+  }
+}
+
+void setUp()
+{
+  // whatever an earlier test left behind has timed out
+  Host::advanceMs(10000);
+  receiver.configure(1, 1);
+  TEST_ASSERT_TRUE(receiver.open(TEST_PORT));
+  sender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+}
+
+void tearDown()
+{
+  receiver.close();
+  close(sender);
+}
+
+void test_frame_from_one_source()
+{
+  send(dataPacket(SOURCE_A, 1, 100, 1, 42));
+  TEST_ASSERT_EQUAL(42, shown());
+  TEST_ASSERT_EQUAL(1, receiver.stats.packets);
+  TEST_ASSERT_EQUAL(1, receiver.frame.frames);
+  TEST_ASSERT_EQUAL(-1, shown());
+}
+
+void test_newest_frame_wins()
+{
+  for (int sequence = 1; sequence <= 5; sequence++)
+  {
+    send(dataPacket(SOURCE_A, 1, 100, sequence, sequence * 10));
+  }
+  TEST_ASSERT_EQUAL(50, shown());
+  TEST_ASSERT_EQUAL(5, receiver.stats.queueDepth);
+  TEST_ASSERT_EQUAL(4, receiver.frame.stale);
+}
+
+void test_ignores_other_data()
+{
+  send(dataPacket(SOURCE_A, 2, 100, 1, 10));
+  send(dataPacket(SOURCE_A, 1, 100, 2, 20, 0, SACN_OPTION_PREVIEW));
+  std::vector<uint8_t> packet = dataPacket(SOURCE_A, 1, 100, 3, 30);
+  packet[SACN_DATA_HEADER_SIZE - 1] = 0xDD;
+  send(packet);
+  packet = dataPacket(SOURCE_A, 1, 100, 4, 40);
+  packet[4] = 'X';
+  send(packet);
+  packet.resize(SACN_MIN_PACKET_SIZE - 1);
+  send(packet);
+  TEST_ASSERT_EQUAL(-1, shown());
+  TEST_ASSERT_EQUAL(3, receiver.stats.ignored);
+  TEST_ASSERT_EQUAL(2, receiver.stats.malformed);
+}
+
+void test_priority_takeover()
+{
+  send(dataPacket(SOURCE_A, 1, 100, 1, 10));
+  TEST_ASSERT_EQUAL(10, shown());
+
+  // a higher priority takes over right away
+  send(dataPacket(SOURCE_B, 1, 150, 1, 20));
+  TEST_ASSERT_EQUAL(20, shown());
+
+  // the lower one is dropped while the higher one is alive
+  send(dataPacket(SOURCE_A, 1, 100, 2, 10));
+  TEST_ASSERT_EQUAL(-1, shown());
+  TEST_ASSERT_EQUAL(1, receiver.stats.lowerPriority);
+
+  // and takes over once it timed out
+  Host::advanceMs(SACN_TIMEOUT_MS + 1);
+  send(dataPacket(SOURCE_A, 1, 100, 3, 10));
+  TEST_ASSERT_EQUAL(10, shown());
+  TEST_ASSERT_EQUAL(3, receiver.stats.sourceChanges);
+}
+
+void test_equal_priority_is_not_merged()
+{
+  send(dataPacket(SOURCE_A, 1, 100, 1, 10));
+  send(dataPacket(SOURCE_B, 1, 100, 1, 20));
+  TEST_ASSERT_EQUAL(10, shown());
+  TEST_ASSERT_EQUAL(1, receiver.stats.lowerPriority);
+}
+
+void test_sequence_rejection()
+{
+  send(dataPacket(SOURCE_A, 1, 100, 10, 10));
+  TEST_ASSERT_EQUAL(10, shown());
+
+  // duplicate and late
+  send(dataPacket(SOURCE_A, 1, 100, 10, 11));
+  send(dataPacket(SOURCE_A, 1, 100, 5, 12));
+  TEST_ASSERT_EQUAL(-1, shown());
+  TEST_ASSERT_EQUAL(2, receiver.stats.outOfOrder);
+
+  send(dataPacket(SOURCE_A, 1, 100, 11, 13));
+  TEST_ASSERT_EQUAL(13, shown());
+
+  // more than 20 back, the sender restarted
+  send(dataPacket(SOURCE_A, 1, 100, 11 - 25, 14));
+  TEST_ASSERT_EQUAL(14, shown());
+
+  // and numbers wrap around
+  send(dataPacket(SOURCE_A, 1, 100, 255, 15));
+  send(dataPacket(SOURCE_A, 1, 100, 0, 16));
+  TEST_ASSERT_EQUAL(16, shown());
+  TEST_ASSERT_EQUAL(2, receiver.stats.outOfOrder);
+}
+
+void test_terminated_stream_releases_universe()
+{
+  send(dataPacket(SOURCE_A, 1, 150, 1, 10));
+  send(dataPacket(SOURCE_B, 1, 100, 1, 20));
+  TEST_ASSERT_EQUAL(10, shown());
+
+  // the terminating packet carries no frame
+  send(dataPacket(SOURCE_A, 1, 150, 2, 99, 0, SACN_OPTION_TERMINATED));
+  TEST_ASSERT_EQUAL(-1, shown());
+
+  send(dataPacket(SOURCE_B, 1, 100, 2, 20));
+  TEST_ASSERT_EQUAL(20, shown());
+}
+
+void test_sync_gated_present()
+{
+  send(dataPacket(SOURCE_A, 1, 100, 1, 30, 7000));
+  TEST_ASSERT_EQUAL(-1, shown());
+
+  // a sync for another universe does not count, neither does a cut one
+  send(syncPacket(SOURCE_A, 7001, 1));
+  std::vector<uint8_t> cut = syncPacket(SOURCE_A, 7000, 1);
+  cut.pop_back();
+  send(cut);
+  TEST_ASSERT_EQUAL(-1, shown());
+  TEST_ASSERT_EQUAL(1, receiver.stats.malformed);
+
+  send(syncPacket(SOURCE_A, 7000, 1));
+  TEST_ASSERT_EQUAL(30, shown());
+  TEST_ASSERT_EQUAL(1, receiver.stats.syncs);
+
+  // later data waits for the next sync as well, a late one is dropped
+  send(dataPacket(SOURCE_A, 1, 100, 2, 31, 7000));
+  send(dataPacket(SOURCE_A, 1, 100, 3, 32, 7000));
+  send(syncPacket(SOURCE_A, 7000, 1));
+  TEST_ASSERT_EQUAL(-1, shown());
+  send(syncPacket(SOURCE_A, 7000, 2));
+  TEST_ASSERT_EQUAL(32, shown());
+}
+
+void test_sync_timeout_falls_back()
+{
+  send(dataPacket(SOURCE_A, 1, 100, 1, 30, 7000));
+  TEST_ASSERT_EQUAL(-1, shown());
+
+  // no sync for too long, frames are shown as they complete
+  Host::advanceMs(SACN_TIMEOUT_MS + 1);
+  send(dataPacket(SOURCE_A, 1, 100, 2, 31, 7000));
+  send(dataPacket(SOURCE_A, 1, 100, 3, 32, 7000));
+  TEST_ASSERT_EQUAL(32, shown());
+  TEST_ASSERT_FALSE(receiver.isSynchronous(millis()));
+}
+
+void test_rgb_over_two_universes()
+{
+  receiver.close();
+  receiver.configure(1, 3);
+  TEST_ASSERT_TRUE(receiver.open(TEST_PORT));
+  TEST_ASSERT_EQUAL(2, receiver.frame.getUniverses());
+  TEST_ASSERT_EQUAL(INGEST_RGB8, receiver.frame.getFormat());
+
+  send(dataPacket(SOURCE_A, 1, 100, 1, 60));
+  TEST_ASSERT_EQUAL(-1, shown());
+  send(dataPacket(SOURCE_A, 2, 100, 1, 70));
+  receiver.poll();
+  uint32_t completeUs;
+  const uint8_t *pixels = receiver.frame.take(completeUs);
+  TEST_ASSERT_NOT_NULL(pixels);
+  // 170 pixels in the first universe, the rest in the second
+  TEST_ASSERT_EQUAL(60, pixels[169 * 3 + 2]);
+  TEST_ASSERT_EQUAL(70, pixels[170 * 3]);
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_frame_from_one_source);
+  RUN_TEST(test_newest_frame_wins);
+  RUN_TEST(test_ignores_other_data);
+  RUN_TEST(test_priority_takeover);
+  RUN_TEST(test_equal_priority_is_not_merged);
+  RUN_TEST(test_sequence_rejection);
+  RUN_TEST(test_terminated_stream_releases_universe);
+  RUN_TEST(test_sync_gated_present);
+  RUN_TEST(test_sync_timeout_falls_back);
+  RUN_TEST(test_rgb_over_two_universes);
+  return UNITY_END();
+}
@@ -0,0 +1,176 @@
+#include <unity.h>
+#include <atomic>
+#include <chrono>
+#include "tasks.h"
+
+// The handoff between the control loop and the render task on the host
+// threading shim: the render task sleeps in ulTaskNotifyTake() until its
+// next frame is due, a command posted from another task (Commands_::wake()
+// gives the notification) has to wake it right away, and nothing it was
+// given while drawing may get lost.
+
+namespace
+{
+  typedef std::chrono::steady_clock Clock;
+
+  std::atomic<bool> running;
+  std::atomic<uint32_t> frames;
+  std::atomic<uint32_t> frameDelayMs;
+  TaskLoad renderLoad;
+
+  // renderTask in main.cpp with a frame counter for the work
+  void renderTask(void *)
+  {
+    while (running)
+    {
+      renderLoad.wake();
+      frames++;
+      renderLoad.sleep();
+      ulTaskNotifyTake(pdTRUE, max((TickType_t)1, (TickType_t)pdMS_TO_TICKS(frameDelayMs.load())));
+    }
+  }
+
+  TaskHandle_t startRender(uint32_t delayMs)
+  {
+    running = true;
+    frames = 0;
+    frameDelayMs = delayMs;
+    TaskHandle_t render = Tasks.spawn(renderTask, "render", RENDER_STACK, RENDER_PRIORITY, RENDER_CORE, &renderLoad);
+    // the first frame is drawn right away
+    while (frames == 0)
+    {
+      vTaskDelay(1);
+    }
+    return render;
+  }
+
+  void stopRender(TaskHandle_t render)
+  {
+    running = false;
+    xTaskNotifyGive(render);
+    Host::joinTasks();
+  }
+
+  uint32_t msSince(Clock::time_point start)
+  {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+  }
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+void test_spawn_lists_tasks()
+{
+  Tasks.add("async_udp", 0);
+  TaskHandle_t render = startRender(1000);
+  Tasks.add("loopTask", RENDER_CORE, xTaskGetCurrentTaskHandle());
+
+  bool listed = false;
+  for (const TaskEntry &task : Tasks.getAll())
+  {
+    if (strcmp(task.name, "render") == 0)
+    {
+      listed = true;
+      TEST_ASSERT_TRUE(task.handle == render);
+      TEST_ASSERT_EQUAL(RENDER_CORE, task.core);
+      TEST_ASSERT_TRUE(task.load == &renderLoad);
+      TEST_ASSERT_EQUAL(RENDER_STACK, uxTaskGetStackHighWaterMark(task.handle));
+    }
+    if (strcmp(task.name, "loopTask") == 0)
+    {
+      TEST_ASSERT_TRUE(task.handle == xTaskGetCurrentTaskHandle());
+    }
+    // a library task nobody created yet stays unresolved
+    if (strcmp(task.name, "async_udp") == 0)
+    {
+      TEST_ASSERT_NULL(task.handle);
+    }
+  }
+  TEST_ASSERT_TRUE(listed);
+  stopRender(render);
+}
+
+void test_post_wakes_render()
+{
+  TaskHandle_t render = startRender(1000);
+
+  // the control loop posts a command while the render task sleeps
+  vTaskDelay(20);
+  TEST_ASSERT_EQUAL(1, frames);
+  Clock::time_point posted = Clock::now();
+  xTaskNotifyGive(render);
+  while (frames < 2 && msSince(posted) < 1000)
+  {
+    vTaskDelay(1);
+  }
+  uint32_t wokeMs = msSince(posted);
+  TEST_ASSERT_EQUAL(2, frames);
+  TEST_ASSERT_TRUE(wokeMs < 100);
+
+  stopRender(render);
+}
+
+void test_render_sleeps_until_next_frame()
+{
+  TaskHandle_t render = startRender(20);
+  vTaskDelay(200);
+  uint32_t drawn = frames;
+  stopRender(render);
+
+  // about every 20 ms, not spinning and not stuck
+  TEST_ASSERT_TRUE(drawn >= 4);
+  TEST_ASSERT_TRUE(drawn <= 12);
+}
+
+void test_notifications_not_lost()
+{
+  // the control loop is a task as well, given to itself here
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+
+  // posts while the render task draws wake its next sleep right away, once
+  xTaskNotifyGive(self);
+  xTaskNotifyGive(self);
+  xTaskNotifyGive(self);
+  TEST_ASSERT_EQUAL(3, ulTaskNotifyTake(pdTRUE, 1000));
+
+  Clock::time_point start = Clock::now();
+  TEST_ASSERT_EQUAL(0, ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(20)));
+  TEST_ASSERT_TRUE(msSince(start) >= 20);
+
+  // without clearing, every give wakes one take
+  xTaskNotifyGive(self);
+  xTaskNotifyGive(self);
+  TEST_ASSERT_EQUAL(2, ulTaskNotifyTake(pdFALSE, 0));
+  TEST_ASSERT_EQUAL(1, ulTaskNotifyTake(pdFALSE, 0));
+  TEST_ASSERT_EQUAL(0, ulTaskNotifyTake(pdFALSE, 0));
+}
+
+void test_task_load()
+{
+  TaskLoad load;
+  load.windowStartUs = micros();
+  // busy a quarter of every 100 ms for a second
+  for (int i = 0; i < 10; i++)
+  {
+    load.wake();
+    Host::advanceMs(25);
+    load.sleep();
+    Host::advanceMs(75);
+  }
+  load.wake();
+  load.sleep();
+  TEST_ASSERT_EQUAL(250, load.permille);
+}
+
+int main()
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_spawn_lists_tasks);
+  RUN_TEST(test_post_wakes_render);
+  RUN_TEST(test_render_sleeps_until_next_frame);
+  RUN_TEST(test_notifications_not_lost);
+  RUN_TEST(test_task_load);
+  return UNITY_END();
+}